@@ -5,7 +5,9 @@ Camera init_camera(vec3 start_pos, vec3 start_up, GLfloat start_yaw, GLfloat sta
 {
     Camera camera = {.pos = {start_pos[0], start_pos[1], start_pos[2]},
         .world_up = {start_up[0], start_up[1], start_up[2]}, .yaw = start_yaw,
-        .pitch = start_pitch, .move_speed = start_move_speed, .turn_speed = start_turn_speed, .front = {0.0f, 0.0f, -1.0f}};
+        .pitch = start_pitch, .move_speed = start_move_speed, .turn_speed = start_turn_speed, .front = {0.0f, 0.0f, -1.0f},
+        .fov = glm_rad(45.0f), .aspect = 16.0f / 9.0f, .near_plane = 0.1f, .far_plane = 100.0f,
+        .dirty = CAMERA_DIRTY_POSE | CAMERA_DIRTY_LENS};
     camera.key_control = key_control;
     camera.mouse_control = mouse_control;
     camera.update = update;
@@ -15,6 +17,9 @@ Camera init_camera(vec3 start_pos, vec3 start_up, GLfloat start_yaw, GLfloat sta
 
 void mouse_control(Camera *c, GLfloat x_diff, GLfloat y_diff)
 {
+    if (x_diff == 0.0f && y_diff == 0.0f)
+        return;
+
     x_diff *= c->turn_speed;
     y_diff *= c->turn_speed;
     c->yaw += x_diff;
@@ -28,41 +33,157 @@ void mouse_control(Camera *c, GLfloat x_diff, GLfloat y_diff)
     c->update(c);
 }
 
-void key_control(Camera *c, bool* keys, GLfloat delta_time)
+void key_control(Camera *c, const InputState *input, GLfloat delta_time)
 {
 	GLfloat velocity = c->move_speed * delta_time;
+    vec3 tmp;
 
-	if (keys[GLFW_KEY_W]) {
-        vec3 tmp;
+	if (input_key(input, GLFW_KEY_W)) {
         glm_vec3_scale(c->front, velocity, tmp);
         glm_vec3_add(c->pos, tmp, c->pos);
+        c->dirty |= CAMERA_DIRTY_POSE;
 	}
-	if (keys[GLFW_KEY_S]) {
-        vec3 tmp;
+	if (input_key(input, GLFW_KEY_S)) {
         glm_vec3_scale(c->front, velocity, tmp);
         glm_vec3_sub(c->pos, tmp, c->pos);
+        c->dirty |= CAMERA_DIRTY_POSE;
 	}
-    if (keys[GLFW_KEY_A]) {
-        vec3 tmp;
+    if (input_key(input, GLFW_KEY_A)) {
         glm_vec3_scale(c->right, velocity, tmp);
         glm_vec3_sub(c->pos, tmp, c->pos);
+        c->dirty |= CAMERA_DIRTY_POSE;
 	}
 
-	if (keys[GLFW_KEY_D]) {
-        vec3 tmp;
+	if (input_key(input, GLFW_KEY_D)) {
         glm_vec3_scale(c->right, velocity, tmp);
         glm_vec3_add(c->pos, tmp, c->pos);
+        c->dirty |= CAMERA_DIRTY_POSE;
 	}
 }
 
 void update(Camera *c)
 {
-    c->front[0] = cos(glm_rad(c->yaw)) * cos(glm_rad(c->pitch));
+    float cos_pitch = cos(glm_rad(c->pitch));
+    c->front[0] = cos(glm_rad(c->yaw)) * cos_pitch;
     c->front[1] = sin(glm_rad(c->pitch));
-    c->front[2] = sin(glm_rad(c->yaw)) * cos(glm_rad(c->pitch));
+    c->front[2] = sin(glm_rad(c->yaw)) * cos_pitch;
     glm_vec3_normalize(c->front);
     glm_cross(c->front, c->world_up, c->right);
     glm_vec3_normalize(c->right);
     glm_cross(c->right, c->front, c->up);
     glm_normalize(c->up);
+    c->dirty |= CAMERA_DIRTY_POSE;
+}
+
+void camera_set_lens(Camera *c, float fov, float aspect, float near_plane, float far_plane)
+{
+    if (c->fov == fov && c->aspect == aspect && c->near_plane == near_plane
+            && c->far_plane == far_plane && c->ortho_height == 0.0f)
+        return;
+    c->fov = fov;
+    c->aspect = aspect;
+    c->near_plane = near_plane;
+    c->far_plane = far_plane;
+    c->ortho_height = 0.0f;
+    c->dirty |= CAMERA_DIRTY_LENS;
+}
+
+void camera_set_ortho(Camera *c, float height, float aspect, float near_plane, float far_plane)
+{
+    if (c->ortho_height == height && c->aspect == aspect && c->near_plane == near_plane
+            && c->far_plane == far_plane)
+        return;
+    c->ortho_height = height;
+    c->aspect = aspect;
+    c->near_plane = near_plane;
+    c->far_plane = far_plane;
+    c->dirty |= CAMERA_DIRTY_LENS;
+}
+
+/* Orients the camera directly instead of through yaw/pitch, for views
+ * driven by something other than the player (cube faces, lights). */
+void camera_look(Camera *c, vec3 pos, vec3 front, vec3 up)
+{
+    glm_vec3_copy(pos, c->pos);
+    glm_vec3_normalize_to(front, c->front);
+    glm_cross(c->front, up, c->right);
+    glm_vec3_normalize(c->right);
+    glm_cross(c->right, c->front, c->up);
+    c->dirty |= CAMERA_DIRTY_POSE;
+}
+
+/* Face order and up vectors follow GL_TEXTURE_CUBE_MAP_POSITIVE_X + face. */
+void camera_cube_face(Camera *c, vec3 pos, int face, float near_plane, float far_plane)
+{
+    static const vec3 fronts[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    static const vec3 ups[6] = {{0, -1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}, {0, -1, 0}, {0, -1, 0}};
+
+    camera_look(c, pos, (float *) fronts[face], (float *) ups[face]);
+    camera_set_lens(c, glm_rad(90.0f), 1.0f, near_plane, far_plane);
+}
+
+/* Puts c's pose between a (alpha 0) and b (alpha 1), the last two
+ * simulation states; the lens is left alone. Only marks c dirty when the
+ * result differs, so a camera at rest stays clean. */
+void camera_interpolate(Camera *c, const Camera *a, const Camera *b, float alpha)
+{
+    vec3 pos;
+    glm_vec3_lerp((float *) a->pos, (float *) b->pos, alpha, pos);
+    float yaw = glm_lerp(a->yaw, b->yaw, alpha);
+    float pitch = glm_lerp(a->pitch, b->pitch, alpha);
+
+    if (glm_vec3_eqv(pos, c->pos) && yaw == c->yaw && pitch == c->pitch)
+        return;
+    glm_vec3_copy(pos, c->pos);
+    c->yaw = yaw;
+    c->pitch = pitch;
+    c->update(c);
+}
+
+/* Rebuilds whatever the dirty flags invalidated. Returns false, touching
+ * nothing, when the camera has not changed since the last call, so callers
+ * can skip uniform uploads and culling for that view. */
+bool camera_refresh(Camera *c)
+{
+    if (!c->dirty)
+        return false;
+
+    if (c->dirty & CAMERA_DIRTY_POSE) {
+        vec3 center;
+        glm_vec3_add(c->pos, c->front, center);
+        glm_lookat(c->pos, center, c->up, c->view_matrix);
+    }
+    if (c->dirty & CAMERA_DIRTY_LENS) {
+        if (c->ortho_height > 0.0f) {
+            float h = c->ortho_height * 0.5f, w = h * c->aspect;
+            glm_ortho(-w, w, -h, h, c->near_plane, c->far_plane, c->projection);
+        } else {
+            glm_perspective(c->fov, c->aspect, c->near_plane, c->far_plane, c->projection);
+        }
+    }
+
+    glm_mat4_mul(c->projection, c->view_matrix, c->view_projection);
+    glm_mat4_inv(c->view_projection, c->inv_view_projection);
+    glm_frustum_planes(c->view_projection, c->planes);
+    c->dirty = 0;
+    c->version++;
+    return true;
+}
+
+/* One pass over every view of the frame (split screen, cube faces, shadow
+ * cascades); static views cost a flag test. Returns how many changed. */
+unsigned int camera_refresh_all(Camera *cameras, unsigned int count)
+{
+    unsigned int changed = 0;
+    for (unsigned int i = 0; i < count; i++)
+        changed += camera_refresh(&cameras[i]);
+    return changed;
+}
+
+bool camera_sphere_visible(const Camera *c, vec3 center, float radius)
+{
+    for (int i = 0; i < 6; i++)
+        if (glm_vec3_dot((float *) c->planes[i], center) + c->planes[i][3] < -radius)
+            return false;
+    return true;
 }
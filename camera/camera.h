@@ -1,22 +1,48 @@
 #pragma once
 #include <cglm/types.h>
+#include <stdbool.h>
+#include "input.h"
 typedef struct Camera Camera;
-void key_control (Camera *, bool *, float);
+void key_control (Camera *, const InputState *, float);
 void mouse_control (Camera *, float, float);
 void update (Camera *);
 
+#define CAMERA_DIRTY_POSE 1u    /* pos or orientation changed */
+#define CAMERA_DIRTY_LENS 2u    /* projection parameters changed */
+
+enum {PLANE_LEFT, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR};
+
 struct Camera {
     vec3 pos, front, up, right, world_up;
     float yaw, pitch;
     float move_speed, turn_speed;
-    mat4 view_matrix;
 
-    void(*key_control) (Camera *, bool *, float);
+    /* Perspective unless ortho_height > 0, which gives an orthographic
+     * volume that many units tall (shadow cascades). */
+    float fov, aspect, near_plane, far_plane;
+    float ortho_height;
+
+    /* Derived state, only recomputed by camera_refresh() when dirty. */
+    mat4 view_matrix, projection, view_projection, inv_view_projection;
+    vec4 planes[6];             /* world space, normals point inwards */
+    unsigned int dirty;
+    unsigned int version;       /* bumped whenever the derived state changes */
+
+    void(*key_control) (Camera *, const InputState *, float);
     void(*mouse_control) (Camera *, float, float);
     void(*update) (Camera *);
 };
 
 Camera init_camera(vec3 start_pos, vec3 start_up, float start_yaw, float start_pitch, float start_move_speed, float start_turn_speed);
 void mouse_control(Camera *c, float x_diff, float y_diff);
-void key_control(Camera *c, bool* keys, float delta_time);
+void key_control(Camera *c, const InputState *input, float delta_time);
 void update(Camera *c);
+
+void camera_set_lens(Camera *c, float fov, float aspect, float near_plane, float far_plane);
+void camera_set_ortho(Camera *c, float height, float aspect, float near_plane, float far_plane);
+void camera_look(Camera *c, vec3 pos, vec3 front, vec3 up);
+void camera_cube_face(Camera *c, vec3 pos, int face, float near_plane, float far_plane);
+void camera_interpolate(Camera *c, const Camera *a, const Camera *b, float alpha);
+bool camera_refresh(Camera *c);
+unsigned int camera_refresh_all(Camera *cameras, unsigned int count);
+bool camera_sphere_visible(const Camera *c, vec3 center, float radius);
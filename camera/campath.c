@@ -0,0 +1,299 @@
+#include "campath.h"
+#include "log.h"
+#include <cglm/cglm.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool campath_init(CamPath *p)
+{
+    memset(p, 0, sizeof(*p));
+    const char *record = getenv("CAMPATH_RECORD");
+    const char *play = getenv("CAMPATH_PLAY");
+    const char *hz = getenv("CAMPATH_HZ");
+
+    if (record && *record) {
+        p->record = fopen(record, "w");
+        if (!p->record) {
+            log_error("campath: can't write %s", record);
+        } else {
+            fprintf(p->record, "# camera path recorded by camera\n");
+            log_info("campath: recording camera path to %s", record);
+        }
+    }
+    if (!play || !*play)
+        return false;
+
+    double rate = hz ? atof(hz) : CAMPATH_DEFAULT_RATE;
+    if (rate <= 0.0) {
+        log_error("campath: invalid CAMPATH_HZ '%s', using %.0f Hz", hz, CAMPATH_DEFAULT_RATE);
+        rate = CAMPATH_DEFAULT_RATE;
+    }
+    p->step = 1.0 / rate;
+    if (!campath_load(p, play))
+        exit(1);
+    log_info("campath: playing %s, %u keys over %.2f s at %.0f Hz", play, p->key_count,
+             p->keys[p->key_count - 1].time, rate);
+    return true;
+}
+
+static void write_pending(CamPath *p)
+{
+    const CamKey *k = &p->pending;
+    fprintf(p->record, "key %.6f %.6f %.6f %.6f %.6f %.6f\n", k->time, k->pos[0], k->pos[1], k->pos[2],
+            k->yaw, k->pitch);
+    p->has_pending = false;
+}
+
+void campath_close(CamPath *p)
+{
+    if (p->record) {
+        if (p->has_pending)
+            write_pending(p);
+        if (fclose(p->record))
+            log_error("campath: writing the recording failed");
+        p->record = NULL;
+    }
+    for (unsigned int i = 0; i < p->segment_count; i++)
+        free(p->segments[i].frame_ms);
+    free(p->keys);
+    p->keys = NULL;
+    p->key_count = p->segment_count = 0;
+}
+
+/* Key changes since the previous call and the mouse motion taken, as the
+ * simulation saw them at time. */
+void campath_record_input(CamPath *p, double time, const InputState *s, float dx, float dy)
+{
+    if (!p->record)
+        return;
+    for (int i = 0; i < INPUT_KEYS / 64; i++) {
+        uint64_t changed = s->keys[i] ^ p->keys_down[i];
+        for (; changed; changed &= changed - 1) {
+            int bit = __builtin_ctzll(changed);
+            bool down = s->keys[i] >> bit & 1;
+            fprintf(p->record, "%s %.6f %d\n", down ? "down" : "up", time, i * 64 + bit);
+        }
+        p->keys_down[i] = s->keys[i];
+    }
+    if (dx != 0.0f || dy != 0.0f)
+        fprintf(p->record, "mouse %.6f %.3f %.3f\n", time, dx, dy);
+}
+
+/* Mouse look lands on the newest tick after it was simulated, so a pose is
+ * only written once the clock moves past it. */
+void campath_record_pose(CamPath *p, double time, const Camera *c)
+{
+    if (!p->record)
+        return;
+    if (p->has_pending && p->pending.time != time)
+        write_pending(p);
+    p->pending = (CamKey) {time, {c->pos[0], c->pos[1], c->pos[2]}, c->yaw, c->pitch};
+    p->has_pending = true;
+}
+
+static bool add_segment(CamPath *p, double start, const char *name)
+{
+    if (p->segment_count == CAMPATH_MAX_SEGMENTS)
+        return false;
+    CamSegment *s = &p->segments[p->segment_count++];
+    *s = (CamSegment) {.start = start};
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    return true;
+}
+
+bool campath_load(CamPath *p, const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        log_error("campath: can't open %s", path);
+        return false;
+    }
+
+    char line[256];
+    unsigned int capacity = 0, number = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        char kind[16], name[CAMPATH_NAME];
+        double time;
+        number++;
+        if (line[0] == '#' || sscanf(line, "%15s", kind) != 1)
+            continue;
+
+        if (!strcmp(kind, "key")) {
+            CamKey k;
+            if (sscanf(line, "%*s %lf %f %f %f %f %f", &k.time, &k.pos[0], &k.pos[1], &k.pos[2],
+                       &k.yaw, &k.pitch) != 6) {
+                log_error("campath: %s:%u: malformed key", path, number);
+                ok = false;
+            } else if (p->key_count && k.time <= p->keys[p->key_count - 1].time) {
+                log_error("campath: %s:%u: keys out of time order", path, number);
+                ok = false;
+            } else {
+                if (p->key_count == capacity) {
+                    capacity = capacity ? capacity * 2 : 256;
+                    p->keys = realloc(p->keys, sizeof(CamKey) * capacity);
+                    if (!p->keys) {
+                        log_fatal("campath: out of memory for %u keys", capacity);
+                        exit(1);
+                    }
+                }
+                p->keys[p->key_count++] = k;
+            }
+        } else if (!strcmp(kind, "segment")) {
+            if (sscanf(line, "%*s %lf %31s", &time, name) != 2) {
+                log_error("campath: %s:%u: malformed segment", path, number);
+                ok = false;
+            } else if (p->segment_count && time < p->segments[p->segment_count - 1].start) {
+                log_error("campath: %s:%u: segments out of time order", path, number);
+                ok = false;
+            } else if (!add_segment(p, time, name)) {
+                log_error("campath: %s:%u: more than %d segments", path, number, CAMPATH_MAX_SEGMENTS);
+                ok = false;
+            }
+        } else if (strcmp(kind, "down") && strcmp(kind, "up") && strcmp(kind, "mouse")) {
+            log_error("campath: %s:%u: unknown record '%s'", path, number, kind);
+            ok = false;
+        }
+    }
+    fclose(f);
+
+    if (ok && p->key_count < 2) {
+        log_error("campath: %s needs at least two keys", path);
+        ok = false;
+    }
+    if (!ok)
+        return false;
+
+    /* Frames before the first named segment still get counted. */
+    if (!p->segment_count || p->segments[0].start > p->keys[0].time) {
+        if (p->segment_count == CAMPATH_MAX_SEGMENTS)
+            p->segment_count--;
+        memmove(&p->segments[1], &p->segments[0], sizeof(CamSegment) * p->segment_count);
+        p->segment_count++;
+        p->segments[0] = (CamSegment) {.start = p->keys[0].time};
+        snprintf(p->segments[0].name, sizeof(p->segments[0].name), "path");
+    }
+    p->source = path;
+    p->frame = 0;
+    p->segment = 0;
+    p->last_swap = -1.0;
+    return true;
+}
+
+/* Cubic Hermite segment from a to b with Catmull-Rom tangents, scaled for
+ * keys that are not evenly spaced in time. */
+static float spline(float p0, float p1, float p2, float p3, double t0, double t1, double t2, double t3, float u)
+{
+    float h = t2 - t1;
+    float m1 = (p2 - p0) / (t2 - t0) * h;
+    float m2 = (p3 - p1) / (t3 - t1) * h;
+    float u2 = u * u, u3 = u2 * u;
+    return (2 * u3 - 3 * u2 + 1) * p1 + (u3 - 2 * u2 + u) * m1 + (-2 * u3 + 3 * u2) * p2 + (u3 - u2) * m2;
+}
+
+static unsigned int find_key(const CamPath *p, double time)
+{
+    unsigned int lo = 0, hi = p->key_count - 1;
+    while (hi - lo > 1) {
+        unsigned int mid = (lo + hi) / 2;
+        if (p->keys[mid].time <= time)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/* Poses c for the next frame; returns false once the path is over. Like
+ * camera_interpolate(), c is only marked dirty when the pose changes. */
+bool campath_next(CamPath *p, Camera *c)
+{
+    double time = p->keys[0].time + p->frame * p->step;
+    if (time > p->keys[p->key_count - 1].time)
+        return false;
+
+    while (p->segment + 1 < p->segment_count && p->segments[p->segment + 1].start <= time)
+        p->segment++;
+
+    unsigned int i = find_key(p, time);
+    const CamKey *k1 = &p->keys[i], *k2 = &p->keys[i + 1];
+    const CamKey *k0 = i ? &p->keys[i - 1] : k1;
+    const CamKey *k3 = i + 2 < p->key_count ? &p->keys[i + 2] : k2;
+    /* Repeating the end keys makes the end tangents one-sided differences. */
+    double t0 = k0->time, t3 = k3->time;
+    float u = (time - k1->time) / (k2->time - k1->time);
+
+    vec3 pos;
+    for (int j = 0; j < 3; j++)
+        pos[j] = spline(k0->pos[j], k1->pos[j], k2->pos[j], k3->pos[j], t0, k1->time, k2->time, t3, u);
+    float yaw = spline(k0->yaw, k1->yaw, k2->yaw, k3->yaw, t0, k1->time, k2->time, t3, u);
+    float pitch = spline(k0->pitch, k1->pitch, k2->pitch, k3->pitch, t0, k1->time, k2->time, t3, u);
+    pitch = glm_clamp(pitch, -89.0f, 89.0f);
+
+    if (!glm_vec3_eqv(pos, c->pos) || yaw != c->yaw || pitch != c->pitch) {
+        glm_vec3_copy(pos, c->pos);
+        c->yaw = yaw;
+        c->pitch = pitch;
+        c->update(c);
+    }
+    return true;
+}
+
+/* Swap-to-swap time, charged to the segment of the frame just swapped. */
+void campath_frame_done(CamPath *p, double swap_time)
+{
+    if (p->last_swap >= 0.0) {
+        CamSegment *s = &p->segments[p->segment];
+        if (s->count == s->capacity) {
+            s->capacity = s->capacity ? s->capacity * 2 : 256;
+            s->frame_ms = realloc(s->frame_ms, sizeof(float) * s->capacity);
+            if (!s->frame_ms) {
+                log_fatal("campath: out of memory for frame times");
+                exit(1);
+            }
+        }
+        s->frame_ms[s->count++] = (swap_time - p->last_swap) * 1e3;
+    }
+    p->last_swap = swap_time;
+    p->frame++;
+}
+
+static int cmp_float(const void *a, const void *b)
+{
+    float x = *(const float *) a, y = *(const float *) b;
+    return (x > y) - (x < y);
+}
+
+void campath_report(CamPath *p)
+{
+    const char *json = getenv("CAMPATH_REPORT");
+    FILE *out = NULL;
+    if (json && *json && !(out = fopen(json, "w")))
+        log_error("campath: can't write %s", json);
+    if (out)
+        fprintf(out, "{\n  \"path\": \"%s\",\n  \"rate\": %.1f,\n  \"frames\": %lu,\n  \"segments\": [\n",
+                p->source, 1.0 / p->step, p->frame);
+
+    bool first = true;
+    for (unsigned int i = 0; i < p->segment_count; i++) {
+        CamSegment *s = &p->segments[i];
+        if (!s->count)
+            continue;
+        double sum = 0.0;
+        for (unsigned int j = 0; j < s->count; j++)
+            sum += s->frame_ms[j];
+        qsort(s->frame_ms, s->count, sizeof(float), cmp_float);
+        float p50 = s->frame_ms[s->count * 50 / 100], p99 = s->frame_ms[s->count * 99 / 100];
+        log_info("campath: %-16s %5u frames  avg %7.3f  p50 %7.3f  p99 %7.3f  max %7.3f ms", s->name,
+                 s->count, sum / s->count, p50, p99, s->frame_ms[s->count - 1]);
+        if (out)
+            fprintf(out, "%s    {\"name\": \"%s\", \"frames\": %u, \"avg\": %.4f, \"p50\": %.4f, "
+                    "\"p99\": %.4f, \"max\": %.4f}", first ? "" : ",\n", s->name, s->count,
+                    sum / s->count, p50, p99, s->frame_ms[s->count - 1]);
+        first = false;
+    }
+    if (out) {
+        fprintf(out, "\n  ]\n}\n");
+        fclose(out);
+    }
+}
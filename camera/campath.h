@@ -0,0 +1,72 @@
+#pragma once
+#include "camera.h"
+#include <stdio.h>
+
+#define CAMPATH_DEFAULT_RATE 60.0   /* playback frames per second of path time */
+#define CAMPATH_MAX_SEGMENTS 64
+#define CAMPATH_NAME 32
+
+typedef struct {
+    double time;
+    vec3 pos;
+    float yaw, pitch;
+} CamKey;
+
+/* Frame times, in milliseconds, of the frames drawn inside one segment. */
+typedef struct {
+    char name[CAMPATH_NAME];
+    double start;               /* path time the segment begins at */
+    float *frame_ms;
+    unsigned int count, capacity;
+} CamSegment;
+
+/* Camera paths for reproducible fly-throughs.
+ *
+ * $CAMPATH_RECORD=file records the session: the pose of every simulation
+ * tick and, at tick resolution, the key and mouse input the simulation
+ * consumed. $CAMPATH_PLAY=file plays a path back instead of taking input:
+ * frame n is drawn at path time n / $CAMPATH_HZ (default
+ * CAMPATH_DEFAULT_RATE) whatever the wall clock says, so every run draws
+ * the same frames, and the run ends after the last key. Frame times are
+ * collected per segment and logged at the end, and written as JSON to
+ * $CAMPATH_REPORT when set.
+ *
+ * The file is text, one record per line, so paths can be written by hand:
+ *
+ *     key <time> <x> <y> <z> <yaw> <pitch>
+ *     segment <time> <name>
+ *     down <time> <key>      up <time> <key>      mouse <time> <dx> <dy>
+ *
+ * Keys must be in time order; poses between them follow a Catmull-Rom
+ * spline. A recording holds a key per tick, which the spline passes
+ * through exactly. Input records are kept for inspection; playback only
+ * follows the keys. Lines starting with '#' are comments. */
+typedef struct {
+    /* Recording, on the simulation thread. */
+    FILE *record;
+    CamKey pending;             /* newest pose, written once time moves on */
+    bool has_pending;
+    uint64_t keys_down[INPUT_KEYS / 64];
+
+    /* Playback, on the render thread. */
+    const char *source;
+    CamKey *keys;
+    unsigned int key_count;
+    CamSegment segments[CAMPATH_MAX_SEGMENTS];
+    unsigned int segment_count, segment;   /* segment holds the current frame */
+    double step;                /* path seconds per frame */
+    unsigned long frame;
+    double last_swap;
+} CamPath;
+
+/* Reads the environment; returns true when a path is to be played. */
+bool campath_init(CamPath *p);
+void campath_close(CamPath *p);
+
+void campath_record_input(CamPath *p, double time, const InputState *s, float dx, float dy);
+void campath_record_pose(CamPath *p, double time, const Camera *c);
+
+bool campath_load(CamPath *p, const char *path);
+bool campath_next(CamPath *p, Camera *c);
+void campath_frame_done(CamPath *p, double swap_time);
+void campath_report(CamPath *p);
@@ -0,0 +1,194 @@
+#include "capture.h"
+#include "gl_loader.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct {
+    bool active;
+    char path[256];
+    int width, height;
+    unsigned long frames, max_frames;
+    unsigned long calls;
+    uint64_t frames_end;
+    unsigned char *data;
+    size_t used, capacity;
+} cap;
+
+static inline void reserve(size_t n)
+{
+    if (cap.used + n <= cap.capacity)
+        return;
+    size_t capacity = cap.capacity ? cap.capacity : 1 << 20;
+    while (capacity < cap.used + n)
+        capacity *= 2;
+    cap.data = realloc(cap.data, capacity);
+    if (!cap.data) {
+        log_fatal("capture: out of memory growing the stream to %zu bytes", capacity);
+        exit(1);
+    }
+    cap.capacity = capacity;
+}
+
+static inline void put(const void *v, size_t n)
+{
+    reserve(n);
+    memcpy(cap.data + cap.used, v, n);
+    cap.used += n;
+}
+
+static inline void pad4(void)
+{
+    static const unsigned char zero[4];
+    put(zero, -cap.used & 3);
+}
+
+void capture_init(int width, int height)
+{
+    const char *path = getenv("GL_CAPTURE");
+    const char *frames = getenv("GL_CAPTURE_FRAMES");
+
+    if (path && *path)
+        capture_start(path, width, height, frames ? strtoul(frames, NULL, 10) : CAPTURE_DEFAULT_FRAMES);
+}
+
+/* The context must be current; entry points are resolved eagerly so no
+ * trampoline can patch a wrapper out. */
+bool capture_start(const char *path, int width, int height, unsigned long frames)
+{
+    if (cap.active)
+        return false;
+    if (strlen(path) >= sizeof(cap.path)) {
+        log_error("capture: path too long: %s", path);
+        return false;
+    }
+    strcpy(cap.path, path);
+    cap.width = width;
+    cap.height = height;
+    cap.frames = 0;
+    cap.max_frames = frames;
+    cap.calls = 0;
+    cap.frames_end = 0;
+    cap.used = 0;
+    cap.active = true;
+    gl_capture_hook();
+    log_info("capture: recording GL calls to %s", path);
+    return true;
+}
+
+static bool write_file(FILE *f)
+{
+    static const unsigned char zero[8];
+    uint32_t header[5] = {CAPTURE_VERSION, cap.width, cap.height, cap.frames, gl_loader_count};
+    size_t size = 8 + sizeof(header) + sizeof(cap.frames_end);
+
+    if (fwrite(CAPTURE_MAGIC, 1, 8, f) != 8 || fwrite(header, sizeof(header), 1, f) != 1
+        || fwrite(&cap.frames_end, sizeof(cap.frames_end), 1, f) != 1)
+        return false;
+    for (unsigned int i = 0; i < gl_loader_count; i++) {
+        uint16_t len = strlen(gl_loader_names[i]);
+        if (fwrite(&len, sizeof(len), 1, f) != 1 || fwrite(gl_loader_names[i], 1, len, f) != len)
+            return false;
+        size += sizeof(len) + len;
+    }
+    if (fwrite(zero, 1, -size & 7, f) != (-size & 7))
+        return false;
+    return fwrite(cap.data, 1, cap.used, f) == cap.used;
+}
+
+void capture_stop(void)
+{
+    if (!cap.active)
+        return;
+    gl_capture_unhook();
+    cap.active = false;
+
+    FILE *f = fopen(cap.path, "wb");
+    if (!f || !write_file(f))
+        log_error("capture: writing %s failed", cap.path);
+    else
+        log_info("capture: %lu frames, %lu calls, %.1f MiB written to %s",
+                 cap.frames, cap.calls, cap.used / 1048576.0, cap.path);
+    if (f)
+        fclose(f);
+
+    free(cap.data);
+    cap.data = NULL;
+    cap.used = cap.capacity = 0;
+}
+
+bool capture_active(void)
+{
+    return cap.active;
+}
+
+void capture_frame(void)
+{
+    if (!cap.active)
+        return;
+    capture_call(CAPTURE_FRAME);
+    cap.frames++;
+    cap.frames_end = cap.used;
+    if (cap.used > CAPTURE_MAX_BYTES)
+        log_warn("capture: stream passed %u MiB, stopping early", CAPTURE_MAX_BYTES >> 20);
+    if ((cap.max_frames && cap.frames >= cap.max_frames) || cap.used > CAPTURE_MAX_BYTES)
+        capture_stop();
+}
+
+void capture_call(uint16_t id)
+{
+    put(&id, sizeof(id));
+    cap.calls += id != CAPTURE_FRAME;
+}
+
+void capture_u32(uint32_t v)
+{
+    put(&v, sizeof(v));
+}
+
+void capture_u64(uint64_t v)
+{
+    put(&v, sizeof(v));
+}
+
+void capture_f32(float v)
+{
+    put(&v, sizeof(v));
+}
+
+void capture_bytes(const void *data, uint64_t size)
+{
+    capture_u64(data ? size : CAPTURE_NULL);
+    if (!data)
+        return;
+    pad4();
+    put(data, size);
+    pad4();
+}
+
+/* Stored with the terminator so replay can hand the payload straight to GL. */
+void capture_string(const char *s)
+{
+    capture_bytes(s, s ? strlen(s) + 1 : 0);
+}
+
+/* glShaderSource() pieces, joined into one string. */
+void capture_sources(int count, const char *const *strings, const int *lengths)
+{
+    uint64_t size = 1;
+    for (int i = 0; i < count; i++)
+        size += lengths && lengths[i] >= 0 ? (uint64_t) lengths[i] : strlen(strings[i]);
+
+    capture_u64(size);
+    pad4();
+    for (int i = 0; i < count; i++)
+        put(strings[i], lengths && lengths[i] >= 0 ? (size_t) lengths[i] : strlen(strings[i]));
+    put("", 1);
+    pad4();
+}
+
+void capture_u32_array(const uint32_t *v, int count)
+{
+    put(v, sizeof(*v) * count);
+}
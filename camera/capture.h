@@ -0,0 +1,52 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CAPTURE_MAGIC "GLCAPTR1"
+#define CAPTURE_VERSION 1
+#define CAPTURE_FRAME 0xffff            /* call id marking the end of a frame */
+#define CAPTURE_NULL UINT64_MAX         /* payload size of a NULL pointer */
+#define CAPTURE_DEFAULT_FRAMES 300
+#define CAPTURE_MAX_BYTES (512u << 20)  /* stops early at the next frame past this */
+
+/* GL command stream capture.
+ *
+ * While active, every entry point in the loader is swapped for a wrapper
+ * (generated into gl_capture.c) that calls the driver and then appends the
+ * call id, the arguments and any payload it reads from memory - buffer
+ * uploads, shader sources, uniform values - to an in-memory stream. Object
+ * names are stored as the driver returned them; glreplay remaps them.
+ * window_swap() marks frame ends. The file is written when the capture
+ * stops, so the cost while recording is a memcpy per call.
+ *
+ * $GL_CAPTURE=file starts a capture as soon as the context exists and
+ * stops after $GL_CAPTURE_FRAMES frames (default CAPTURE_DEFAULT_FRAMES,
+ * 0 for no limit) or at destroy_window(). Everything runs on the thread
+ * owning the context.
+ *
+ * File layout: CAPTURE_MAGIC, u32 version, u32 width, u32 height, u32 frame
+ * count, u32 name count, u64 offset of the end of the last frame in the
+ * record stream, then per entry point a u16 length and its name, zero
+ * padded to 8 bytes. Then records: u16 call id (an index into the names, or
+ * CAPTURE_FRAME) and the arguments as u32/u64 in declaration order.
+ * Payloads are a u64 size followed by the data, each padded to 4 bytes.
+ * Calls after the last frame are teardown. */
+void capture_init(int width, int height);
+bool capture_start(const char *path, int width, int height, unsigned long frames);
+void capture_stop(void);
+bool capture_active(void);
+void capture_frame(void);
+
+/* Used by the generated wrappers. */
+void capture_call(uint16_t id);
+void capture_u32(uint32_t v);
+void capture_u64(uint64_t v);
+void capture_f32(float v);
+void capture_bytes(const void *data, uint64_t size);
+void capture_string(const char *s);
+void capture_sources(int count, const char *const *strings, const int *lengths);
+void capture_u32_array(const uint32_t *v, int count);
+
+/* Generated into gl_capture.c. */
+void gl_capture_hook(void);
+void gl_capture_unhook(void);
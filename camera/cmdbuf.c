@@ -0,0 +1,273 @@
+#include "cmdbuf.h"
+#include "log.h"
+#include "profile.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CMD_ALIGN 8
+
+typedef struct {
+    uint32_t type;
+    GLuint program;
+} CmdUseProgram;
+
+typedef struct {
+    uint32_t type;
+    GLint location;
+    GLfloat m[16];
+} CmdUniformMat4;
+
+typedef struct {
+    uint32_t type;
+    GLuint vao;     /* carries its element buffer */
+} CmdBindMesh;
+
+/* A range of a uniform buffer, usually one draw's slice of the stream ring. */
+typedef struct {
+    uint32_t type;
+    GLuint binding;
+    GLuint buffer;
+    uint64_t offset, size;
+} CmdBindUniforms;
+
+typedef struct {
+    uint32_t type;
+    GLsizei count;
+    uint64_t offset;
+} CmdDrawElements;
+
+static const size_t cmd_size[] = {
+    [CMD_END] = sizeof(uint32_t),
+    [CMD_USE_PROGRAM] = sizeof(CmdUseProgram),
+    [CMD_UNIFORM_MAT4] = sizeof(CmdUniformMat4),
+    [CMD_BIND_MESH] = sizeof(CmdBindMesh),
+    [CMD_BIND_UNIFORMS] = sizeof(CmdBindUniforms),
+    [CMD_DRAW_ELEMENTS] = sizeof(CmdDrawElements),
+};
+
+static inline size_t aligned_size(uint32_t type)
+{
+    return (cmd_size[type] + CMD_ALIGN - 1) & ~(size_t) (CMD_ALIGN - 1);
+}
+
+static void *cmd_push(CmdBuffer *b, uint32_t type)
+{
+    size_t size = aligned_size(type);
+
+    if (b->used + size > b->capacity) {
+        b->capacity = b->capacity ? b->capacity * 2 : 64 * 1024;
+        b->data = realloc(b->data, b->capacity);
+        if (!b->data) {
+            log_fatal("cmdbuf: out of memory growing to %zu bytes", b->capacity);
+            exit(1);
+        }
+    }
+
+    void *cmd = b->data + b->used;
+    *(uint32_t *) cmd = type;
+    b->used += size;
+    return cmd;
+}
+
+void cmd_queue_init(CmdQueue *q)
+{
+    memset(q, 0, sizeof(*q));
+}
+
+void cmd_queue_destroy(CmdQueue *q)
+{
+    for (int i = 0; i < JOB_MAX_WORKERS; i++) {
+        free(q->buffers[i].data);
+        free(q->buffers[i].packets);
+    }
+    free(q->merged);
+    memset(q, 0, sizeof(*q));
+}
+
+/* The calling worker's buffer; threads outside the pool share slot 0 with
+ * the main thread and must not record concurrently with it. */
+CmdBuffer *cmd_thread_buffer(CmdQueue *q)
+{
+    int id = job_worker_index();
+    return &q->buffers[id < 0 ? 0 : id];
+}
+
+void cmd_begin(CmdBuffer *b, uint64_t key)
+{
+    if (b->packet_count == b->packet_capacity) {
+        b->packet_capacity = b->packet_capacity ? b->packet_capacity * 2 : 256;
+        b->packets = realloc(b->packets, sizeof(*b->packets) * b->packet_capacity);
+        if (!b->packets) {
+            log_fatal("cmdbuf: out of memory growing to %u packets", b->packet_capacity);
+            exit(1);
+        }
+    }
+    b->packets[b->packet_count++] = (CmdPacket) {key, (uint32_t) b->used, 0};
+}
+
+void cmd_end(CmdBuffer *b)
+{
+    cmd_push(b, CMD_END);
+}
+
+/* Aliased names interleave unrelated programs or meshes in the sort, which
+ * quietly costs the binds sorting saves. Recorded from any thread. */
+static void check_key_name(const char *what, GLuint name)
+{
+    static atomic_bool warned;
+    if (name > CMD_KEY_NAME_MAX && !atomic_exchange_explicit(&warned, true, memory_order_relaxed))
+        log_warn("cmdbuf: %s %u does not fit a sort key, draws may not batch", what, name);
+}
+
+void cmd_use_program(CmdBuffer *b, GLuint program)
+{
+    check_key_name("program", program);
+    CmdUseProgram *cmd = cmd_push(b, CMD_USE_PROGRAM);
+    cmd->program = program;
+}
+
+void cmd_uniform_mat4(CmdBuffer *b, GLint location, const GLfloat *m)
+{
+    CmdUniformMat4 *cmd = cmd_push(b, CMD_UNIFORM_MAT4);
+    cmd->location = location;
+    memcpy(cmd->m, m, sizeof(cmd->m));
+}
+
+void cmd_bind_mesh(CmdBuffer *b, GLuint vao)
+{
+    check_key_name("vertex array", vao);
+    CmdBindMesh *cmd = cmd_push(b, CMD_BIND_MESH);
+    cmd->vao = vao;
+}
+
+void cmd_bind_uniforms(CmdBuffer *b, GLuint binding, GLuint buffer, size_t offset, size_t size)
+{
+    CmdBindUniforms *cmd = cmd_push(b, CMD_BIND_UNIFORMS);
+    cmd->binding = binding;
+    cmd->buffer = buffer;
+    cmd->offset = offset;
+    cmd->size = size;
+}
+
+void cmd_draw_elements(CmdBuffer *b, GLsizei count, size_t offset)
+{
+    CmdDrawElements *cmd = cmd_push(b, CMD_DRAW_ELEMENTS);
+    cmd->count = count;
+    cmd->offset = offset;
+}
+
+/* Ties keep recording order so replay is deterministic. */
+static int packet_cmp(const void *a, const void *b)
+{
+    const CmdPacket *pa = a, *pb = b;
+    if (pa->key != pb->key)
+        return pa->key < pb->key ? -1 : 1;
+    if (pa->buffer != pb->buffer)
+        return pa->buffer < pb->buffer ? -1 : 1;
+    return pa->offset < pb->offset ? -1 : pa->offset > pb->offset;
+}
+
+/* Merge every thread's packets by key and execute them. Must run on the
+ * thread owning the GL context, after recording has finished. Program and
+ * geometry binds that match the current state are dropped. Each run of
+ * draws with one program is a "batch" CPU and GPU profiler scope. */
+void cmd_queue_submit(CmdQueue *q)
+{
+    unsigned int total = 0;
+    for (int i = 0; i < JOB_MAX_WORKERS; i++)
+        total += q->buffers[i].packet_count;
+
+    if (total > q->merged_capacity) {
+        q->merged_capacity = total * 2;
+        q->merged = realloc(q->merged, sizeof(*q->merged) * q->merged_capacity);
+        if (!q->merged) {
+            log_fatal("cmdbuf: out of memory merging %u packets", total);
+            exit(1);
+        }
+    }
+
+    unsigned int n = 0;
+    for (int i = 0; i < JOB_MAX_WORKERS; i++) {
+        CmdBuffer *b = &q->buffers[i];
+        for (unsigned int p = 0; p < b->packet_count; p++) {
+            q->merged[n] = b->packets[p];
+            q->merged[n++].buffer = i;
+        }
+    }
+    qsort(q->merged, n, sizeof(*q->merged), packet_cmp);
+
+    GLuint program = 0, vao = 0;
+    bool batch = false;
+    for (unsigned int p = 0; p < n; p++) {
+        const unsigned char *cmd = q->buffers[q->merged[p].buffer].data + q->merged[p].offset;
+
+        for (;;) {
+            uint32_t type = *(const uint32_t *) cmd;
+            if (type == CMD_END)
+                break;
+
+            switch (type) {
+            case CMD_USE_PROGRAM: {
+                const CmdUseProgram *c = (const void *) cmd;
+                if (c->program == program) {
+                    q->skipped++;
+                    break;
+                }
+                if (batch) {
+                    prof_gpu_end();
+                    prof_end();
+                }
+                prof_begin("batch");
+                prof_gpu_begin("batch");
+                batch = true;
+                glUseProgram(c->program);
+                program = c->program;
+                q->replayed++;
+                break;
+            }
+            case CMD_UNIFORM_MAT4: {
+                const CmdUniformMat4 *c = (const void *) cmd;
+                glUniformMatrix4fv(c->location, 1, GL_FALSE, c->m);
+                q->replayed++;
+                break;
+            }
+            case CMD_BIND_MESH: {
+                const CmdBindMesh *c = (const void *) cmd;
+                if (c->vao == vao) {
+                    q->skipped++;
+                    break;
+                }
+                glBindVertexArray(c->vao);
+                vao = c->vao;
+                q->replayed++;
+                break;
+            }
+            case CMD_BIND_UNIFORMS: {
+                const CmdBindUniforms *c = (const void *) cmd;
+                glBindBufferRange(GL_UNIFORM_BUFFER, c->binding, c->buffer, c->offset, c->size);
+                q->replayed++;
+                break;
+            }
+            case CMD_DRAW_ELEMENTS: {
+                const CmdDrawElements *c = (const void *) cmd;
+                glDrawElements(GL_TRIANGLES, c->count, GL_UNSIGNED_INT, (void *) (uintptr_t) c->offset);
+                q->replayed++;
+                break;
+            }
+            }
+            cmd += aligned_size(type);
+        }
+    }
+    if (batch) {
+        prof_gpu_end();
+        prof_end();
+    }
+
+    glBindVertexArray(0);
+
+    for (int i = 0; i < JOB_MAX_WORKERS; i++) {
+        q->buffers[i].used = 0;
+        q->buffers[i].packet_count = 0;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "gl_loader.h"
+#include "job.h"
+
+/* Sort keys: program, then geometry, then a caller-chosen sequence (depth,
+ * submission order...). A packet with vao 0 and seq 0 sorts ahead of every
+ * draw using the same program, which is where per-program uniforms go.
+ * Names above CMD_KEY_NAME_MAX alias; cmd_use_program() and
+ * cmd_bind_mesh() warn the first time one is recorded. */
+#define CMD_KEY_NAME_MAX 0xffff
+#define CMD_KEY(program, vao, seq) \
+    (((uint64_t) ((program) & CMD_KEY_NAME_MAX) << 48) | ((uint64_t) ((vao) & CMD_KEY_NAME_MAX) << 32) \
+     | (uint32_t) (seq))
+
+enum {
+    CMD_END,
+    CMD_USE_PROGRAM,
+    CMD_UNIFORM_MAT4,
+    CMD_BIND_MESH,
+    CMD_BIND_UNIFORMS,
+    CMD_DRAW_ELEMENTS
+};
+
+typedef struct {
+    uint64_t key;
+    uint32_t offset;    /* of the packet's first command in data */
+    uint32_t buffer;    /* filled in when merging */
+} CmdPacket;
+
+/* Linear per-thread recording buffer. Only its owner writes to it. */
+typedef struct {
+    unsigned char *data;
+    size_t used, capacity;
+    CmdPacket *packets;
+    unsigned int packet_count, packet_capacity;
+} CmdBuffer;
+
+typedef struct {
+    CmdBuffer buffers[JOB_MAX_WORKERS];
+    CmdPacket *merged;
+    unsigned int merged_capacity;
+    unsigned long replayed, skipped;    /* commands executed / filtered as redundant */
+} CmdQueue;
+
+void cmd_queue_init(CmdQueue *q);
+void cmd_queue_destroy(CmdQueue *q);
+CmdBuffer *cmd_thread_buffer(CmdQueue *q);
+void cmd_queue_submit(CmdQueue *q);
+
+void cmd_begin(CmdBuffer *b, uint64_t key);
+void cmd_end(CmdBuffer *b);
+void cmd_use_program(CmdBuffer *b, GLuint program);
+void cmd_uniform_mat4(CmdBuffer *b, GLint location, const GLfloat *m);
+void cmd_bind_mesh(CmdBuffer *b, GLuint vao);
+void cmd_bind_uniforms(CmdBuffer *b, GLuint binding, GLuint buffer, size_t offset, size_t size);
+void cmd_draw_elements(CmdBuffer *b, GLsizei count, size_t offset);
@@ -0,0 +1,251 @@
+#include "ecs.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGN(x, a) (((x) + (a) - 1) & ~((size_t) (a) - 1))
+#define ENTITY_INDEX(e) ((e) & ((1u << ECS_INDEX_BITS) - 1))
+#define ENTITY_GEN(e) ((e) >> ECS_INDEX_BITS)
+
+static const size_t comp_size[COMP_COUNT] = {
+    [COMP_TRANSFORM] = sizeof(Transform),
+    [COMP_MESH] = sizeof(MeshRef),
+    [COMP_BOUNDS] = sizeof(Bounds),
+    [COMP_MATERIAL] = sizeof(Material),
+};
+
+static void archetype_layout(EcsArchetype *a, unsigned int mask)
+{
+    size_t stride = sizeof(Entity);
+    for (int c = 0; c < COMP_COUNT; c++)
+        if (mask & COMP_BIT(c))
+            stride += comp_size[c];
+
+    /* Leave room for aligning every column to a cache line. */
+    a->mask = mask;
+    a->chunk_capacity = (ECS_CHUNK_SIZE - 64 * (COMP_COUNT + 1)) / stride;
+
+    size_t off = ALIGN(sizeof(Entity) * a->chunk_capacity, 64);
+    for (int c = 0; c < COMP_COUNT; c++) {
+        if (!(mask & COMP_BIT(c)))
+            continue;
+        a->offsets[c] = off;
+        off = ALIGN(off + comp_size[c] * a->chunk_capacity, 64);
+    }
+}
+
+static inline Entity *chunk_entities(EcsChunk *chunk)
+{
+    return (Entity *) chunk->memory;
+}
+
+static inline void *chunk_column(EcsArchetype *a, EcsChunk *chunk, int comp, unsigned int row)
+{
+    return chunk->memory + a->offsets[comp] + comp_size[comp] * row;
+}
+
+/* Rows are always appended to the last chunk, so only it can have room. */
+static unsigned int archetype_push(EcsArchetype *a, Entity e, unsigned int *row)
+{
+    if (!a->chunk_count || a->chunks[a->chunk_count - 1].count == a->chunk_capacity) {
+        if (a->chunk_count == a->chunk_alloc) {
+            a->chunk_alloc = a->chunk_alloc ? a->chunk_alloc * 2 : 4;
+            a->chunks = realloc(a->chunks, sizeof(*a->chunks) * a->chunk_alloc);
+        }
+        unsigned char *memory = a->chunks ? aligned_alloc(64, ECS_CHUNK_SIZE) : NULL;
+        if (!memory) {
+            log_fatal("ecs: out of memory allocating a chunk");
+            exit(1);
+        }
+        a->chunks[a->chunk_count++] = (EcsChunk) {0, memory};
+    }
+
+    unsigned int c = a->chunk_count - 1;
+    EcsChunk *chunk = &a->chunks[c];
+    *row = chunk->count++;
+    chunk_entities(chunk)[*row] = e;
+    for (int comp = 0; comp < COMP_COUNT; comp++)
+        if (a->mask & COMP_BIT(comp))
+            memset(chunk_column(a, chunk, comp, *row), 0, comp_size[comp]);
+    return c;
+}
+
+/* Fill the hole with the archetype's last row so chunks stay dense. */
+static void archetype_remove(EcsWorld *w, EcsArchetype *a, unsigned int c, unsigned int row)
+{
+    EcsChunk *last = &a->chunks[a->chunk_count - 1];
+    EcsChunk *chunk = &a->chunks[c];
+    unsigned int last_row = last->count - 1;
+
+    if (chunk != last || row != last_row) {
+        Entity moved = chunk_entities(last)[last_row];
+        chunk_entities(chunk)[row] = moved;
+        for (int comp = 0; comp < COMP_COUNT; comp++)
+            if (a->mask & COMP_BIT(comp))
+                memcpy(chunk_column(a, chunk, comp, row), chunk_column(a, last, comp, last_row), comp_size[comp]);
+        w->records[ENTITY_INDEX(moved)].chunk = c;
+        w->records[ENTITY_INDEX(moved)].row = row;
+    }
+
+    if (!--last->count) {
+        free(last->memory);
+        a->chunk_count--;
+    }
+}
+
+void ecs_init(EcsWorld *w)
+{
+    memset(w, 0, sizeof(*w));
+    w->free_head = ECS_NULL;
+    for (unsigned int mask = 0; mask < ECS_ARCHETYPES; mask++)
+        archetype_layout(&w->archetypes[mask], mask);
+}
+
+void ecs_destroy(EcsWorld *w)
+{
+    for (unsigned int mask = 0; mask < ECS_ARCHETYPES; mask++) {
+        EcsArchetype *a = &w->archetypes[mask];
+        for (unsigned int c = 0; c < a->chunk_count; c++)
+            free(a->chunks[c].memory);
+        free(a->chunks);
+    }
+    free(w->records);
+    memset(w, 0, sizeof(*w));
+}
+
+Entity ecs_create(EcsWorld *w, unsigned int mask)
+{
+    uint32_t index;
+
+    if (mask >= ECS_ARCHETYPES) {
+        log_error("ecs: component mask %#x out of range", mask);
+        return ECS_NULL;
+    }
+    if (w->free_head != ECS_NULL) {
+        index = w->free_head;
+        w->free_head = w->records[index].next_free;
+    } else {
+        if (w->record_count == 1u << ECS_INDEX_BITS) {
+            log_error("ecs: entity limit reached");
+            return ECS_NULL;
+        }
+        if (w->record_count == w->record_alloc) {
+            w->record_alloc = w->record_alloc ? w->record_alloc * 2 : 64;
+            w->records = realloc(w->records, sizeof(*w->records) * w->record_alloc);
+            if (!w->records) {
+                log_fatal("ecs: out of memory growing to %u entities", w->record_alloc);
+                exit(1);
+            }
+        }
+        index = w->record_count++;
+        w->records[index].generation = 0;
+    }
+
+    EcsRecord *r = &w->records[index];
+    Entity e = index | (r->generation << ECS_INDEX_BITS);
+    r->archetype = mask;
+    r->chunk = archetype_push(&w->archetypes[mask], e, &r->row);
+    return e;
+}
+
+bool ecs_alive(const EcsWorld *w, Entity e)
+{
+    uint32_t index = ENTITY_INDEX(e);
+    return index < w->record_count && w->records[index].archetype >= 0
+        && w->records[index].generation == ENTITY_GEN(e);
+}
+
+void ecs_destroy_entity(EcsWorld *w, Entity e)
+{
+    if (!ecs_alive(w, e))
+        return;
+
+    EcsRecord *r = &w->records[ENTITY_INDEX(e)];
+    archetype_remove(w, &w->archetypes[r->archetype], r->chunk, r->row);
+    r->archetype = -1;
+    r->generation = (r->generation + 1) & ((1u << (32 - ECS_INDEX_BITS)) - 1);
+    r->next_free = w->free_head;
+    w->free_head = ENTITY_INDEX(e);
+}
+
+/* Move an entity to the archetype of mask, keeping the components both
+ * archetypes share and zeroing the new ones. */
+void ecs_set_mask(EcsWorld *w, Entity e, unsigned int mask)
+{
+    if (mask >= ECS_ARCHETYPES) {
+        log_error("ecs: component mask %#x out of range", mask);
+        return;
+    }
+    if (!ecs_alive(w, e))
+        return;
+
+    EcsRecord *r = &w->records[ENTITY_INDEX(e)];
+    if ((unsigned int) r->archetype == mask)
+        return;
+
+    EcsArchetype *from = &w->archetypes[r->archetype], *to = &w->archetypes[mask];
+    unsigned int row;
+    unsigned int c = archetype_push(to, e, &row);
+
+    EcsChunk *src = &from->chunks[r->chunk], *dst = &to->chunks[c];
+    for (int comp = 0; comp < COMP_COUNT; comp++)
+        if (from->mask & to->mask & COMP_BIT(comp))
+            memcpy(chunk_column(to, dst, comp, row), chunk_column(from, src, comp, r->row), comp_size[comp]);
+
+    archetype_remove(w, from, r->chunk, r->row);
+    r->archetype = mask;
+    r->chunk = c;
+    r->row = row;
+}
+
+void *ecs_get(EcsWorld *w, Entity e, int comp)
+{
+    if (!ecs_alive(w, e))
+        return NULL;
+
+    EcsRecord *r = &w->records[ENTITY_INDEX(e)];
+    EcsArchetype *a = &w->archetypes[r->archetype];
+    if (!(a->mask & COMP_BIT(comp)))
+        return NULL;
+    return chunk_column(a, &a->chunks[r->chunk], comp, r->row);
+}
+
+static void make_view(EcsArchetype *a, EcsChunk *chunk, EcsView *view)
+{
+    view->count = chunk->count;
+    view->entities = chunk_entities(chunk);
+    for (int comp = 0; comp < COMP_COUNT; comp++)
+        view->columns[comp] = a->mask & COMP_BIT(comp) ? chunk->memory + a->offsets[comp] : NULL;
+}
+
+/* Fill views with every chunk whose archetype has all components in mask.
+ * Returns the number of matching chunks, which may exceed max_views. */
+unsigned int ecs_query(EcsWorld *w, unsigned int mask, EcsView *views, unsigned int max_views)
+{
+    unsigned int n = 0;
+
+    for (unsigned int m = 0; m < ECS_ARCHETYPES; m++) {
+        if ((m & mask) != mask)
+            continue;
+        EcsArchetype *a = &w->archetypes[m];
+        for (unsigned int c = 0; c < a->chunk_count; c++, n++)
+            if (n < max_views)
+                make_view(a, &a->chunks[c], &views[n]);
+    }
+
+    return n;
+}
+
+void ecs_each(EcsWorld *w, unsigned int mask, void (*fn)(EcsView *, void *), void *udata)
+{
+    for (unsigned int m = 0; m < ECS_ARCHETYPES; m++) {
+        if ((m & mask) != mask)
+            continue;
+        EcsArchetype *a = &w->archetypes[m];
+        for (unsigned int c = 0; c < a->chunk_count; c++) {
+            EcsView view;
+            make_view(a, &a->chunks[c], &view);
+            fn(&view, udata);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "gl_loader.h"
+#include <cglm/cglm.h>
+#include "lod.h"
+
+#define ECS_CHUNK_SIZE (16 * 1024)
+#define ECS_INDEX_BITS 24
+#define ECS_NULL 0xffffffffu
+
+enum {
+    COMP_TRANSFORM,
+    COMP_MESH,
+    COMP_BOUNDS,
+    COMP_MATERIAL,
+    COMP_COUNT
+};
+
+#define COMP_BIT(c) (1u << (c))
+#define ECS_ARCHETYPES (1u << COMP_COUNT)
+#define ECS_COLUMN(view, type, comp) ((type *) (view).columns[comp])
+
+/* Low ECS_INDEX_BITS are the slot, the rest a generation that invalidates
+ * stale handles once the slot is reused. */
+typedef uint32_t Entity;
+
+typedef struct {
+    int node;           /* scene node */
+} Transform;
+
+typedef struct {
+    LodMesh *mesh;
+    int lod;            /* currently selected level */
+    bool culled;        /* outside the view frustum last time it was tested */
+} MeshRef;
+
+typedef struct {
+    vec3 center;        /* world space */
+    float radius;
+} Bounds;
+
+typedef struct {
+    GLuint program;
+} Material;
+
+/* One fixed-size block of an archetype: an Entity array followed by one
+ * tightly packed column per component. */
+typedef struct {
+    unsigned int count;
+    unsigned char *memory;
+} EcsChunk;
+
+typedef struct {
+    unsigned int mask;
+    unsigned int chunk_capacity;
+    size_t offsets[COMP_COUNT];
+    EcsChunk *chunks;
+    unsigned int chunk_count, chunk_alloc;
+} EcsArchetype;
+
+typedef struct {
+    int archetype;      /* -1 while the slot is free */
+    unsigned int chunk, row;
+    uint32_t generation;
+    uint32_t next_free;
+} EcsRecord;
+
+/* Archetypes are indexed directly by their component mask. */
+typedef struct {
+    EcsArchetype archetypes[ECS_ARCHETYPES];
+    EcsRecord *records;
+    uint32_t record_count, record_alloc;
+    uint32_t free_head;
+} EcsWorld;
+
+/* A contiguous run of entities matched by a query. Views are independent,
+ * so systems can hand them to different threads. */
+typedef struct {
+    unsigned int count;
+    Entity *entities;
+    void *columns[COMP_COUNT];
+} EcsView;
+
+void ecs_init(EcsWorld *w);
+void ecs_destroy(EcsWorld *w);
+Entity ecs_create(EcsWorld *w, unsigned int mask);
+void ecs_destroy_entity(EcsWorld *w, Entity e);
+bool ecs_alive(const EcsWorld *w, Entity e);
+void ecs_set_mask(EcsWorld *w, Entity e, unsigned int mask);
+void *ecs_get(EcsWorld *w, Entity e, int comp);
+unsigned int ecs_query(EcsWorld *w, unsigned int mask, EcsView *views, unsigned int max_views);
+void ecs_each(EcsWorld *w, unsigned int mask, void (*fn)(EcsView *, void *), void *udata);
@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""Generates gl_loader.h and gl_loader.c from glcorearb.h.
+
+Only the functions and extensions listed in gl_loader.txt are emitted.
+Every function pointer starts out at a trampoline that resolves the real
+entry point on first call and patches the pointer, so startup resolves
+nothing.
+
+Also writes the capture wrappers (gl_capture.c) and the matching replay
+dispatch (gl_replay.c), see capture.h, and the GL_COUNTERS call counters
+(gl_counters.c), see gl_debug.h. Pointer parameters have no size in
+the header, so each one needs a rule below; the generator refuses to emit
+a function it can't capture.
+
+usage: gen_gl_loader.py [gl_loader.txt] [/usr/include/GL/glcorearb.h]
+"""
+import re
+import sys
+
+LIST = sys.argv[1] if len(sys.argv) > 1 else "gl_loader.txt"
+HEADER = sys.argv[2] if len(sys.argv) > 2 else "/usr/include/GL/glcorearb.h"
+
+# Needed by the extension check itself.
+REQUIRED = ["glGetIntegerv", "glGetStringi"]
+
+# Object namespaces for replay remapping, by parameter name.
+NAMESPACES = {
+    "buffer": "REPLAY_BUFFER", "buffers": "REPLAY_BUFFER",
+    "array": "REPLAY_VERTEX_ARRAY", "arrays": "REPLAY_VERTEX_ARRAY",
+    "shader": "REPLAY_SHADER", "shaders": "REPLAY_SHADER",
+    "program": "REPLAY_PROGRAM",
+    "framebuffer": "REPLAY_FRAMEBUFFER", "framebuffers": "REPLAY_FRAMEBUFFER",
+    "renderbuffer": "REPLAY_RENDERBUFFER", "renderbuffers": "REPLAY_RENDERBUFFER",
+    "id": "REPLAY_QUERY", "ids": "REPLAY_QUERY",
+}
+
+# Return values that name new objects.
+RETURNS = {
+    "glCreateShader": ("name", "REPLAY_SHADER"),
+    "glCreateProgram": ("name", "REPLAY_PROGRAM"),
+    "glFenceSync": ("sync",),
+    "glGetUniformLocation": ("location",),
+}
+
+# Object names whose namespace depends on another argument.
+OBJECTS = {("glObjectLabel", "name"): "identifier"}
+
+# Parameters that need more than their value, as (function, parameter).
+RULES = {
+    ("glBufferData", "data"): ("bytes", "size"),
+    ("glBufferSubData", "data"): ("bytes", "size"),
+    ("glBufferStorage", "data"): ("bytes", "size"),
+    ("glDrawElements", "indices"): ("offset",),
+    ("glVertexAttribPointer", "pointer"): ("offset",),
+    ("glUniformMatrix4fv", "value"): ("bytes", "16 * count * sizeof(GLfloat)"),
+    ("glGetUniformLocation", "name"): ("string",),
+    ("glGetUniformBlockIndex", "uniformBlockName"): ("string",),
+    ("glShaderSource", "count"): ("const", "1"),
+    ("glShaderSource", "string"): ("sources",),
+    ("glShaderSource", "length"): ("const", "NULL"),
+    ("glDebugMessageCallback", "callback"): ("const", "NULL"),
+    ("glDebugMessageCallback", "userParam"): ("const", "NULL"),
+    ("glDebugMessageControl", "ids"): ("bytes", "count * sizeof(GLuint)"),
+    # Labels are always passed NUL-terminated with length -1.
+    ("glObjectLabel", "length"): ("const", "-1"),
+    ("glObjectLabel", "label"): ("string",),
+}
+
+# Replay bookkeeping after a call.
+REPLAY_AFTER = {
+    "glUseProgram": "replay_use_program(c_program);",
+}
+
+U32 = {"GLenum", "GLuint", "GLint", "GLsizei", "GLboolean", "GLbitfield"}
+U64 = {"GLuint64", "GLint64", "GLsizeiptr", "GLintptr"}
+
+proto = re.compile(r"^GLAPI (.+?)\s*APIENTRY (gl\w+) \((.*)\);$")
+
+
+def parse_header(path):
+    funcs = {}
+    for line in open(path):
+        m = proto.match(line.strip())
+        if m:
+            ret, name, params = m.groups()
+            funcs[name] = (ret.strip(), params.strip())
+    return funcs
+
+
+def param_names(params):
+    if params == "void":
+        return []
+    return [re.findall(r"\w+", p)[-1] for p in params.split(",")]
+
+
+def split_params(params):
+    if params == "void":
+        return []
+    out = []
+    for p in params.split(","):
+        name = re.findall(r"\w+", p)[-1]
+        out.append((p[:p.rindex(name)].strip(), name))
+    return out
+
+
+def classify(f, ptype, name):
+    if (f, name) in RULES:
+        return RULES[(f, name)]
+    if (f, name) in OBJECTS:
+        return ("object", OBJECTS[(f, name)])
+    base = ptype.replace("const", "").strip()
+    if "*" in ptype:
+        elem = base.rstrip("*").strip()
+        if elem == "GLuint" and name in NAMESPACES and name.endswith("s"):
+            return ("names_out" if "const" not in ptype else "names_in", NAMESPACES[name])
+        if "const" not in ptype:
+            return ("out",)
+        sys.exit("no capture rule for %s(%s %s)" % (f, ptype, name))
+    if base == "GLuint" and name in NAMESPACES:
+        return ("name", NAMESPACES[name])
+    if base == "GLint" and name == "location":
+        return ("location",)
+    if base == "GLsync":
+        return ("sync",)
+    if base == "GLfloat":
+        return ("f32",)
+    if base in U64:
+        return ("u64",)
+    if base in U32:
+        return ("u32",)
+    sys.exit("no capture rule for %s(%s %s)" % (f, ptype, name))
+
+
+def capture_wrapper(i, f, ret, params, pfn):
+    plist = split_params(params)
+    args = ", ".join(n for _, n in plist)
+    out = ["\nstatic %s real_%s;\n" % (pfn, f),
+           "static %s APIENTRY capture_%s(%s)\n{\n" % (ret, f, params)]
+    if ret != "void":
+        out.append("    %s result = real_%s(%s);\n" % (ret, f, args))
+    else:
+        out.append("    real_%s(%s);\n" % (f, args))
+    out.append("    capture_call(%d);\n" % i)
+    for ptype, name in plist:
+        rule = classify(f, ptype, name)
+        kind = rule[0]
+        if kind in ("u32", "name", "location", "object"):
+            out.append("    capture_u32((uint32_t) %s);\n" % name)
+        elif kind == "f32":
+            out.append("    capture_f32(%s);\n" % name)
+        elif kind == "u64":
+            out.append("    capture_u64((uint64_t) %s);\n" % name)
+        elif kind in ("sync", "offset"):
+            out.append("    capture_u64((uint64_t) (uintptr_t) %s);\n" % name)
+        elif kind == "bytes":
+            out.append("    capture_bytes(%s, %s);\n" % (name, rule[1]))
+        elif kind == "string":
+            out.append("    capture_string(%s);\n" % name)
+        elif kind == "sources":
+            out.append("    capture_sources(count, string, length);\n")
+        elif kind in ("names_in", "names_out"):
+            out.append("    capture_u32_array(%s, n);\n" % name)
+    r = RETURNS.get(f)
+    if r and r[0] == "name":
+        out.append("    capture_u32(result);\n")
+    elif r and r[0] == "sync":
+        out.append("    capture_u64((uint64_t) (uintptr_t) result);\n")
+    elif r and r[0] == "location":
+        out.append("    capture_u32((uint32_t) result);\n")
+    if ret != "void":
+        out.append("    return result;\n")
+    out.append("}\n")
+    return out
+
+
+def counter_wrapper(i, f, ret, params):
+    args = ", ".join(param_names(params))
+    out = ["\nstatic %s APIENTRY count_%s(%s)\n{\n" % (ret, f, params),
+           "    gl_counters[%d]++;\n" % i]
+    call = "next_%s(%s);" % (f, args)
+    if ret != "void":
+        call = "%s result = %s" % (ret, call)
+    out.append("    %s\n" % call)
+    # Checking glGetError() itself would recurse.
+    if f != "glGetError":
+        out.append("    if (gl_debug_poll_errors)\n        gl_debug_error(%d, next_glGetError());\n" % i)
+    if ret != "void":
+        out.append("    return result;\n")
+    out.append("}\n")
+    return out
+
+
+def replay_case(i, f, ret, params):
+    plist = split_params(params)
+    out = ["    case %d: {\n" % i]
+    args, slot = [], 0
+    for ptype, name in plist:
+        rule = classify(f, ptype, name)
+        kind, c = rule[0], "c_" + name
+        base = ptype.replace("const", "").strip()
+        if kind == "u32":
+            out.append("        %s %s = (%s) replay_u32();\n" % (base, c, base))
+            args.append(c if name != "bufSize" else
+                        "%s < REPLAY_OUT_SIZE ? %s : REPLAY_OUT_SIZE" % (c, c))
+        elif kind == "f32":
+            out.append("        GLfloat %s = replay_f32();\n" % c)
+            args.append(c)
+        elif kind == "u64":
+            out.append("        %s %s = (%s) replay_u64();\n" % (base, c, base))
+            args.append(c)
+        elif kind == "name":
+            out.append("        GLuint %s = replay_u32();\n" % c)
+            args.append("(GLuint) replay_name(%s, %s)" % (rule[1], c))
+        elif kind == "object":
+            out.append("        GLuint %s = replay_u32();\n" % c)
+            args.append("replay_object(c_%s, %s)" % (rule[1], c))
+        elif kind == "location":
+            out.append("        GLint %s = (GLint) replay_u32();\n" % c)
+            args.append("replay_location(%s)" % c)
+        elif kind == "sync":
+            out.append("        uint64_t %s = replay_u64();\n" % c)
+            args.append("(GLsync) (uintptr_t) replay_name(REPLAY_SYNC, %s)" % c)
+        elif kind == "offset":
+            out.append("        const void *%s = (const void *) (uintptr_t) replay_u64();\n" % c)
+            args.append(c)
+        elif kind == "bytes":
+            out.append("        %s%s = replay_bytes();\n" % (ptype + ("" if ptype.endswith("*") else " "), c))
+            args.append(c)
+        elif kind in ("string", "sources"):
+            out.append("        const GLchar *%s = replay_string();\n" % c)
+            args.append(c if kind == "string" else "&" + c)
+        elif kind == "const":
+            args.append(rule[1])
+        elif kind == "names_in":
+            out.append("        GLuint *%s = replay_names(%s, c_n);\n" % (c, rule[1]))
+            args.append(c)
+        elif kind == "names_out":
+            out.append("        GLuint *%s = replay_scratch(c_n);\n" % c)
+            args.append(c)
+        elif kind == "out":
+            out.append("        void *%s = replay_out(%d);\n" % (c, slot))
+            args.append(c)
+            slot += 1
+    call = "%s(%s);" % (f, ", ".join(args))
+    r = RETURNS.get(f)
+    out.append("        %s%s\n" % ("%s result = " % ret if r else "", call))
+    for ptype, name in plist:
+        rule = classify(f, ptype, name)
+        if rule[0] == "names_out":
+            out.append("        replay_bind_names(%s, c_n, c_%s);\n" % (rule[1], name))
+    if r and r[0] == "name":
+        out.append("        replay_bind_name(%s, replay_u32(), result);\n" % r[1])
+    elif r and r[0] == "sync":
+        out.append("        replay_bind_name(REPLAY_SYNC, replay_u64(), (uint64_t) (uintptr_t) result);\n")
+    elif r and r[0] == "location":
+        out.append("        replay_bind_location(c_program, (GLint) replay_u32(), result);\n")
+    if f in REPLAY_AFTER:
+        out.append("        %s\n" % REPLAY_AFTER[f])
+    out.append("        return true;\n    }\n")
+    return out
+
+
+def main():
+    funcs, exts = [], []
+    for line in open(LIST):
+        line = line.split("#")[0].strip()
+        if not line:
+            continue
+        if line.startswith("GL_"):
+            exts.append(line)
+        else:
+            funcs.append(line)
+    for f in REQUIRED:
+        if f not in funcs:
+            funcs.append(f)
+    funcs = sorted(set(funcs))
+
+    known = parse_header(HEADER)
+    missing = [f for f in funcs if f not in known]
+    if missing:
+        sys.exit("not in %s: %s" % (HEADER, " ".join(missing)))
+
+    note = "/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */\n"
+
+    h = [note, "#pragma once\n",
+         "/* Stand in for gl.h so nothing else declares the GL API. */\n",
+         "#define __gl_h_\n#define __GL_H__\n",
+         "#include <GL/glcorearb.h>\n#include <stdbool.h>\n\n",
+         "typedef void (*GLLoaderProc)(void);\n",
+         "typedef GLLoaderProc (*GLLoaderGetProc)(const char *name);\n\n",
+         "typedef enum {\n"]
+    h += ["    GL_LOADER_%s,\n" % e[3:] for e in exts]
+    h += ["    GL_LOADER_EXT_COUNT\n} GLLoaderExtension;\n\n",
+          "/* get_proc is glfwGetProcAddress or eglGetProcAddress; call it once a\n",
+          " * context is current, before the first GL call. */\n",
+          "void gl_loader_init(GLLoaderGetProc get_proc);\n",
+          "bool gl_loader_has(GLLoaderExtension ext);\n",
+          "unsigned int gl_loader_resolved(void);\n",
+          "/* Entry point names, indexed like the capture and counter tables. */\n",
+          "extern const char *const gl_loader_names[];\n",
+          "extern const unsigned int gl_loader_count;\n",
+          "/* Resolves everything still pointing at a trampoline. */\n",
+          "void gl_loader_resolve_all(void);\n\n"]
+    for f in funcs:
+        pfn = "PFN%sPROC" % f.upper()
+        h.append("extern %s gl_loader_%s;\n#define %s gl_loader_%s\n" % (pfn, f, f, f))
+
+    c = [note, '#include "gl_loader.h"\n#include "log.h"\n#include <stdint.h>\n',
+         "#include <stdlib.h>\n#include <string.h>\n\n",
+         "static GLLoaderGetProc get_proc;\n",
+         "static unsigned int resolved;\n",
+         "static uint64_t extensions;\n",
+         "static bool extensions_known;\n\n",
+         "const char *const gl_loader_names[] = {\n"]
+    c += ['    "%s",\n' % f for f in funcs]
+    c += ["};\n", "const unsigned int gl_loader_count = %d;\n\n" % len(funcs),
+          "static const char *const extension_names[] = {\n"]
+    c += ['    "%s",\n' % e for e in exts]
+    c += ["    NULL\n};\n\n",
+          "void gl_loader_init(GLLoaderGetProc proc)\n{\n",
+          "    get_proc = proc;\n",
+          "    extensions_known = false;\n}\n\n",
+          "unsigned int gl_loader_resolved(void)\n{\n    return resolved;\n}\n\n",
+          "/* Queried once per context, the first time any extension is asked about. */\n",
+          "bool gl_loader_has(GLLoaderExtension ext)\n{\n",
+          "    if (!extensions_known) {\n",
+          "        GLint count = 0;\n",
+          "        glGetIntegerv(GL_NUM_EXTENSIONS, &count);\n",
+          "        extensions = 0;\n",
+          "        for (GLint i = 0; i < count; i++) {\n",
+          "            const char *name = (const char *) glGetStringi(GL_EXTENSIONS, i);\n",
+          "            for (int e = 0; e < GL_LOADER_EXT_COUNT; e++)\n",
+          "                if (!strcmp(name, extension_names[e]))\n",
+          "                    extensions |= UINT64_C(1) << e;\n",
+          "        }\n",
+          "        extensions_known = true;\n",
+          "    }\n",
+          "    return extensions >> ext & 1;\n}\n\n",
+          "/* GL calls stay on the context's thread, so the patch needs no atomics. */\n",
+          "static GLLoaderProc resolve(const char *name)\n{\n",
+          "    GLLoaderProc proc = get_proc ? get_proc(name) : NULL;\n",
+          "    if (!proc) {\n",
+          '        log_fatal("gl_loader: cannot resolve %s", name);\n',
+          "        exit(1);\n    }\n",
+          "    resolved++;\n",
+          "    return proc;\n}\n"]
+    for f in funcs:
+        ret, params = known[f]
+        pfn = "PFN%sPROC" % f.upper()
+        args = ", ".join(param_names(params))
+        call = "gl_loader_%s(%s);" % (f, args)
+        if ret != "void":
+            call = "return " + call
+        c.append("\nstatic %s APIENTRY trampoline_%s(%s)\n{\n" % (ret, f, params))
+        c.append('    gl_loader_%s = (%s) resolve("%s");\n' % (f, pfn, f))
+        c.append("    %s\n}\n" % call)
+        c.append("%s gl_loader_%s = trampoline_%s;\n" % (pfn, f, f))
+
+    c.append("\nvoid gl_loader_resolve_all(void)\n{\n    GLLoaderProc proc;\n")
+    for f in funcs:
+        pfn = "PFN%sPROC" % f.upper()
+        c.append('    if (gl_loader_%s == trampoline_%s && get_proc && (proc = get_proc("%s")))\n'
+                 "        gl_loader_%s = (%s) proc;\n" % (f, f, f, f, pfn))
+    c.append("}\n")
+
+    cap = [note, '#include "gl_loader.h"\n#include "capture.h"\n#include <stdint.h>\n']
+    for i, f in enumerate(funcs):
+        ret, params = known[f]
+        cap += capture_wrapper(i, f, ret, params, "PFN%sPROC" % f.upper())
+    cap.append("\nvoid gl_capture_hook(void)\n{\n    gl_loader_resolve_all();\n")
+    for f in funcs:
+        cap.append("    real_%s = gl_loader_%s;\n    gl_loader_%s = capture_%s;\n" % (f, f, f, f))
+    cap.append("}\n\nvoid gl_capture_unhook(void)\n{\n")
+    for f in funcs:
+        cap.append("    gl_loader_%s = real_%s;\n" % (f, f))
+    cap.append("}\n")
+
+    rep = [note, '#include "replay.h"\n\n',
+           "bool gl_replay_call(unsigned int id)\n{\n    switch (id) {\n"]
+    for i, f in enumerate(funcs):
+        ret, params = known[f]
+        rep += replay_case(i, f, ret, params)
+    rep.append("    default:\n        return false;\n    }\n}\n")
+
+    open("gl_loader.h", "w").write("".join(h))
+    open("gl_loader.c", "w").write("".join(c))
+    cnt = [note, '#include "gl_debug.h"\n\n#ifdef GL_COUNTERS\n',
+           "unsigned long gl_counters[%d];\n\n" % len(funcs)]
+    # All declared up front: every wrapper may call next_glGetError().
+    for f in funcs:
+        cnt.append("static PFN%sPROC next_%s;\n" % (f.upper(), f))
+    for i, f in enumerate(funcs):
+        ret, params = known[f]
+        cnt += counter_wrapper(i, f, ret, params)
+    cnt.append("\nvoid gl_counters_hook(void)\n{\n    static bool hooked;\n"
+               "    if (hooked)\n        return;\n    hooked = true;\n    gl_loader_resolve_all();\n")
+    for f in funcs:
+        cnt.append("    next_%s = gl_loader_%s;\n    gl_loader_%s = count_%s;\n" % (f, f, f, f))
+    cnt.append("}\n#endif\n")
+
+    open("gl_capture.c", "w").write("".join(cap))
+    open("gl_counters.c", "w").write("".join(cnt))
+    open("gl_replay.c", "w").write("".join(rep))
+
+
+if __name__ == "__main__":
+    main()
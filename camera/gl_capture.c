@@ -0,0 +1,835 @@
+/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */
+#include "gl_loader.h"
+#include "capture.h"
+#include <stdint.h>
+
+static PFNGLATTACHSHADERPROC real_glAttachShader;
+static void APIENTRY capture_glAttachShader(GLuint program, GLuint shader)
+{
+    real_glAttachShader(program, shader);
+    capture_call(0);
+    capture_u32((uint32_t) program);
+    capture_u32((uint32_t) shader);
+}
+
+static PFNGLBINDBUFFERPROC real_glBindBuffer;
+static void APIENTRY capture_glBindBuffer(GLenum target, GLuint buffer)
+{
+    real_glBindBuffer(target, buffer);
+    capture_call(1);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) buffer);
+}
+
+static PFNGLBINDBUFFERRANGEPROC real_glBindBufferRange;
+static void APIENTRY capture_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    real_glBindBufferRange(target, index, buffer, offset, size);
+    capture_call(2);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) index);
+    capture_u32((uint32_t) buffer);
+    capture_u64((uint64_t) offset);
+    capture_u64((uint64_t) size);
+}
+
+static PFNGLBINDFRAMEBUFFERPROC real_glBindFramebuffer;
+static void APIENTRY capture_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    real_glBindFramebuffer(target, framebuffer);
+    capture_call(3);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) framebuffer);
+}
+
+static PFNGLBINDRENDERBUFFERPROC real_glBindRenderbuffer;
+static void APIENTRY capture_glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    real_glBindRenderbuffer(target, renderbuffer);
+    capture_call(4);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) renderbuffer);
+}
+
+static PFNGLBINDVERTEXARRAYPROC real_glBindVertexArray;
+static void APIENTRY capture_glBindVertexArray(GLuint array)
+{
+    real_glBindVertexArray(array);
+    capture_call(5);
+    capture_u32((uint32_t) array);
+}
+
+static PFNGLBUFFERDATAPROC real_glBufferData;
+static void APIENTRY capture_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    real_glBufferData(target, size, data, usage);
+    capture_call(6);
+    capture_u32((uint32_t) target);
+    capture_u64((uint64_t) size);
+    capture_bytes(data, size);
+    capture_u32((uint32_t) usage);
+}
+
+static PFNGLBUFFERSTORAGEPROC real_glBufferStorage;
+static void APIENTRY capture_glBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    real_glBufferStorage(target, size, data, flags);
+    capture_call(7);
+    capture_u32((uint32_t) target);
+    capture_u64((uint64_t) size);
+    capture_bytes(data, size);
+    capture_u32((uint32_t) flags);
+}
+
+static PFNGLBUFFERSUBDATAPROC real_glBufferSubData;
+static void APIENTRY capture_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    real_glBufferSubData(target, offset, size, data);
+    capture_call(8);
+    capture_u32((uint32_t) target);
+    capture_u64((uint64_t) offset);
+    capture_u64((uint64_t) size);
+    capture_bytes(data, size);
+}
+
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC real_glCheckFramebufferStatus;
+static GLenum APIENTRY capture_glCheckFramebufferStatus(GLenum target)
+{
+    GLenum result = real_glCheckFramebufferStatus(target);
+    capture_call(9);
+    capture_u32((uint32_t) target);
+    return result;
+}
+
+static PFNGLCLEARPROC real_glClear;
+static void APIENTRY capture_glClear(GLbitfield mask)
+{
+    real_glClear(mask);
+    capture_call(10);
+    capture_u32((uint32_t) mask);
+}
+
+static PFNGLCLEARCOLORPROC real_glClearColor;
+static void APIENTRY capture_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    real_glClearColor(red, green, blue, alpha);
+    capture_call(11);
+    capture_f32(red);
+    capture_f32(green);
+    capture_f32(blue);
+    capture_f32(alpha);
+}
+
+static PFNGLCLIENTWAITSYNCPROC real_glClientWaitSync;
+static GLenum APIENTRY capture_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    GLenum result = real_glClientWaitSync(sync, flags, timeout);
+    capture_call(12);
+    capture_u64((uint64_t) (uintptr_t) sync);
+    capture_u32((uint32_t) flags);
+    capture_u64((uint64_t) timeout);
+    return result;
+}
+
+static PFNGLCOMPILESHADERPROC real_glCompileShader;
+static void APIENTRY capture_glCompileShader(GLuint shader)
+{
+    real_glCompileShader(shader);
+    capture_call(13);
+    capture_u32((uint32_t) shader);
+}
+
+static PFNGLCOPYBUFFERSUBDATAPROC real_glCopyBufferSubData;
+static void APIENTRY capture_glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    real_glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+    capture_call(14);
+    capture_u32((uint32_t) readTarget);
+    capture_u32((uint32_t) writeTarget);
+    capture_u64((uint64_t) readOffset);
+    capture_u64((uint64_t) writeOffset);
+    capture_u64((uint64_t) size);
+}
+
+static PFNGLCREATEPROGRAMPROC real_glCreateProgram;
+static GLuint APIENTRY capture_glCreateProgram(void)
+{
+    GLuint result = real_glCreateProgram();
+    capture_call(15);
+    capture_u32(result);
+    return result;
+}
+
+static PFNGLCREATESHADERPROC real_glCreateShader;
+static GLuint APIENTRY capture_glCreateShader(GLenum type)
+{
+    GLuint result = real_glCreateShader(type);
+    capture_call(16);
+    capture_u32((uint32_t) type);
+    capture_u32(result);
+    return result;
+}
+
+static PFNGLDEBUGMESSAGECALLBACKPROC real_glDebugMessageCallback;
+static void APIENTRY capture_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam)
+{
+    real_glDebugMessageCallback(callback, userParam);
+    capture_call(17);
+}
+
+static PFNGLDEBUGMESSAGECONTROLPROC real_glDebugMessageControl;
+static void APIENTRY capture_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled)
+{
+    real_glDebugMessageControl(source, type, severity, count, ids, enabled);
+    capture_call(18);
+    capture_u32((uint32_t) source);
+    capture_u32((uint32_t) type);
+    capture_u32((uint32_t) severity);
+    capture_u32((uint32_t) count);
+    capture_bytes(ids, count * sizeof(GLuint));
+    capture_u32((uint32_t) enabled);
+}
+
+static PFNGLDELETEBUFFERSPROC real_glDeleteBuffers;
+static void APIENTRY capture_glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    real_glDeleteBuffers(n, buffers);
+    capture_call(19);
+    capture_u32((uint32_t) n);
+    capture_u32_array(buffers, n);
+}
+
+static PFNGLDELETEFRAMEBUFFERSPROC real_glDeleteFramebuffers;
+static void APIENTRY capture_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    real_glDeleteFramebuffers(n, framebuffers);
+    capture_call(20);
+    capture_u32((uint32_t) n);
+    capture_u32_array(framebuffers, n);
+}
+
+static PFNGLDELETEPROGRAMPROC real_glDeleteProgram;
+static void APIENTRY capture_glDeleteProgram(GLuint program)
+{
+    real_glDeleteProgram(program);
+    capture_call(21);
+    capture_u32((uint32_t) program);
+}
+
+static PFNGLDELETEQUERIESPROC real_glDeleteQueries;
+static void APIENTRY capture_glDeleteQueries(GLsizei n, const GLuint *ids)
+{
+    real_glDeleteQueries(n, ids);
+    capture_call(22);
+    capture_u32((uint32_t) n);
+    capture_u32_array(ids, n);
+}
+
+static PFNGLDELETERENDERBUFFERSPROC real_glDeleteRenderbuffers;
+static void APIENTRY capture_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+    real_glDeleteRenderbuffers(n, renderbuffers);
+    capture_call(23);
+    capture_u32((uint32_t) n);
+    capture_u32_array(renderbuffers, n);
+}
+
+static PFNGLDELETESHADERPROC real_glDeleteShader;
+static void APIENTRY capture_glDeleteShader(GLuint shader)
+{
+    real_glDeleteShader(shader);
+    capture_call(24);
+    capture_u32((uint32_t) shader);
+}
+
+static PFNGLDELETESYNCPROC real_glDeleteSync;
+static void APIENTRY capture_glDeleteSync(GLsync sync)
+{
+    real_glDeleteSync(sync);
+    capture_call(25);
+    capture_u64((uint64_t) (uintptr_t) sync);
+}
+
+static PFNGLDELETEVERTEXARRAYSPROC real_glDeleteVertexArrays;
+static void APIENTRY capture_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    real_glDeleteVertexArrays(n, arrays);
+    capture_call(26);
+    capture_u32((uint32_t) n);
+    capture_u32_array(arrays, n);
+}
+
+static PFNGLDETACHSHADERPROC real_glDetachShader;
+static void APIENTRY capture_glDetachShader(GLuint program, GLuint shader)
+{
+    real_glDetachShader(program, shader);
+    capture_call(27);
+    capture_u32((uint32_t) program);
+    capture_u32((uint32_t) shader);
+}
+
+static PFNGLDRAWELEMENTSPROC real_glDrawElements;
+static void APIENTRY capture_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    real_glDrawElements(mode, count, type, indices);
+    capture_call(28);
+    capture_u32((uint32_t) mode);
+    capture_u32((uint32_t) count);
+    capture_u32((uint32_t) type);
+    capture_u64((uint64_t) (uintptr_t) indices);
+}
+
+static PFNGLENABLEPROC real_glEnable;
+static void APIENTRY capture_glEnable(GLenum cap)
+{
+    real_glEnable(cap);
+    capture_call(29);
+    capture_u32((uint32_t) cap);
+}
+
+static PFNGLENABLEVERTEXATTRIBARRAYPROC real_glEnableVertexAttribArray;
+static void APIENTRY capture_glEnableVertexAttribArray(GLuint index)
+{
+    real_glEnableVertexAttribArray(index);
+    capture_call(30);
+    capture_u32((uint32_t) index);
+}
+
+static PFNGLFENCESYNCPROC real_glFenceSync;
+static GLsync APIENTRY capture_glFenceSync(GLenum condition, GLbitfield flags)
+{
+    GLsync result = real_glFenceSync(condition, flags);
+    capture_call(31);
+    capture_u32((uint32_t) condition);
+    capture_u32((uint32_t) flags);
+    capture_u64((uint64_t) (uintptr_t) result);
+    return result;
+}
+
+static PFNGLFINISHPROC real_glFinish;
+static void APIENTRY capture_glFinish(void)
+{
+    real_glFinish();
+    capture_call(32);
+}
+
+static PFNGLFLUSHMAPPEDBUFFERRANGEPROC real_glFlushMappedBufferRange;
+static void APIENTRY capture_glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    real_glFlushMappedBufferRange(target, offset, length);
+    capture_call(33);
+    capture_u32((uint32_t) target);
+    capture_u64((uint64_t) offset);
+    capture_u64((uint64_t) length);
+}
+
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC real_glFramebufferRenderbuffer;
+static void APIENTRY capture_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    real_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    capture_call(34);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) attachment);
+    capture_u32((uint32_t) renderbuffertarget);
+    capture_u32((uint32_t) renderbuffer);
+}
+
+static PFNGLGENBUFFERSPROC real_glGenBuffers;
+static void APIENTRY capture_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+    real_glGenBuffers(n, buffers);
+    capture_call(35);
+    capture_u32((uint32_t) n);
+    capture_u32_array(buffers, n);
+}
+
+static PFNGLGENFRAMEBUFFERSPROC real_glGenFramebuffers;
+static void APIENTRY capture_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+    real_glGenFramebuffers(n, framebuffers);
+    capture_call(36);
+    capture_u32((uint32_t) n);
+    capture_u32_array(framebuffers, n);
+}
+
+static PFNGLGENQUERIESPROC real_glGenQueries;
+static void APIENTRY capture_glGenQueries(GLsizei n, GLuint *ids)
+{
+    real_glGenQueries(n, ids);
+    capture_call(37);
+    capture_u32((uint32_t) n);
+    capture_u32_array(ids, n);
+}
+
+static PFNGLGENRENDERBUFFERSPROC real_glGenRenderbuffers;
+static void APIENTRY capture_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+    real_glGenRenderbuffers(n, renderbuffers);
+    capture_call(38);
+    capture_u32((uint32_t) n);
+    capture_u32_array(renderbuffers, n);
+}
+
+static PFNGLGENVERTEXARRAYSPROC real_glGenVertexArrays;
+static void APIENTRY capture_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+    real_glGenVertexArrays(n, arrays);
+    capture_call(39);
+    capture_u32((uint32_t) n);
+    capture_u32_array(arrays, n);
+}
+
+static PFNGLGETERRORPROC real_glGetError;
+static GLenum APIENTRY capture_glGetError(void)
+{
+    GLenum result = real_glGetError();
+    capture_call(40);
+    return result;
+}
+
+static PFNGLGETINTEGER64VPROC real_glGetInteger64v;
+static void APIENTRY capture_glGetInteger64v(GLenum pname, GLint64 *data)
+{
+    real_glGetInteger64v(pname, data);
+    capture_call(41);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETINTEGERVPROC real_glGetIntegerv;
+static void APIENTRY capture_glGetIntegerv(GLenum pname, GLint *data)
+{
+    real_glGetIntegerv(pname, data);
+    capture_call(42);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETPROGRAMINFOLOGPROC real_glGetProgramInfoLog;
+static void APIENTRY capture_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    real_glGetProgramInfoLog(program, bufSize, length, infoLog);
+    capture_call(43);
+    capture_u32((uint32_t) program);
+    capture_u32((uint32_t) bufSize);
+}
+
+static PFNGLGETPROGRAMIVPROC real_glGetProgramiv;
+static void APIENTRY capture_glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+    real_glGetProgramiv(program, pname, params);
+    capture_call(44);
+    capture_u32((uint32_t) program);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETQUERYOBJECTIVPROC real_glGetQueryObjectiv;
+static void APIENTRY capture_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params)
+{
+    real_glGetQueryObjectiv(id, pname, params);
+    capture_call(45);
+    capture_u32((uint32_t) id);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETQUERYOBJECTUI64VPROC real_glGetQueryObjectui64v;
+static void APIENTRY capture_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+    real_glGetQueryObjectui64v(id, pname, params);
+    capture_call(46);
+    capture_u32((uint32_t) id);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETSHADERINFOLOGPROC real_glGetShaderInfoLog;
+static void APIENTRY capture_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    real_glGetShaderInfoLog(shader, bufSize, length, infoLog);
+    capture_call(47);
+    capture_u32((uint32_t) shader);
+    capture_u32((uint32_t) bufSize);
+}
+
+static PFNGLGETSHADERIVPROC real_glGetShaderiv;
+static void APIENTRY capture_glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+    real_glGetShaderiv(shader, pname, params);
+    capture_call(48);
+    capture_u32((uint32_t) shader);
+    capture_u32((uint32_t) pname);
+}
+
+static PFNGLGETSTRINGPROC real_glGetString;
+static const GLubyte * APIENTRY capture_glGetString(GLenum name)
+{
+    const GLubyte * result = real_glGetString(name);
+    capture_call(49);
+    capture_u32((uint32_t) name);
+    return result;
+}
+
+static PFNGLGETSTRINGIPROC real_glGetStringi;
+static const GLubyte * APIENTRY capture_glGetStringi(GLenum name, GLuint index)
+{
+    const GLubyte * result = real_glGetStringi(name, index);
+    capture_call(50);
+    capture_u32((uint32_t) name);
+    capture_u32((uint32_t) index);
+    return result;
+}
+
+static PFNGLGETUNIFORMBLOCKINDEXPROC real_glGetUniformBlockIndex;
+static GLuint APIENTRY capture_glGetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+    GLuint result = real_glGetUniformBlockIndex(program, uniformBlockName);
+    capture_call(51);
+    capture_u32((uint32_t) program);
+    capture_string(uniformBlockName);
+    return result;
+}
+
+static PFNGLGETUNIFORMLOCATIONPROC real_glGetUniformLocation;
+static GLint APIENTRY capture_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+    GLint result = real_glGetUniformLocation(program, name);
+    capture_call(52);
+    capture_u32((uint32_t) program);
+    capture_string(name);
+    capture_u32((uint32_t) result);
+    return result;
+}
+
+static PFNGLLINKPROGRAMPROC real_glLinkProgram;
+static void APIENTRY capture_glLinkProgram(GLuint program)
+{
+    real_glLinkProgram(program);
+    capture_call(53);
+    capture_u32((uint32_t) program);
+}
+
+static PFNGLMAPBUFFERRANGEPROC real_glMapBufferRange;
+static void * APIENTRY capture_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    void * result = real_glMapBufferRange(target, offset, length, access);
+    capture_call(54);
+    capture_u32((uint32_t) target);
+    capture_u64((uint64_t) offset);
+    capture_u64((uint64_t) length);
+    capture_u32((uint32_t) access);
+    return result;
+}
+
+static PFNGLOBJECTLABELPROC real_glObjectLabel;
+static void APIENTRY capture_glObjectLabel(GLenum identifier, GLuint name, GLsizei length, const GLchar *label)
+{
+    real_glObjectLabel(identifier, name, length, label);
+    capture_call(55);
+    capture_u32((uint32_t) identifier);
+    capture_u32((uint32_t) name);
+    capture_string(label);
+}
+
+static PFNGLQUERYCOUNTERPROC real_glQueryCounter;
+static void APIENTRY capture_glQueryCounter(GLuint id, GLenum target)
+{
+    real_glQueryCounter(id, target);
+    capture_call(56);
+    capture_u32((uint32_t) id);
+    capture_u32((uint32_t) target);
+}
+
+static PFNGLRENDERBUFFERSTORAGEPROC real_glRenderbufferStorage;
+static void APIENTRY capture_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    real_glRenderbufferStorage(target, internalformat, width, height);
+    capture_call(57);
+    capture_u32((uint32_t) target);
+    capture_u32((uint32_t) internalformat);
+    capture_u32((uint32_t) width);
+    capture_u32((uint32_t) height);
+}
+
+static PFNGLSHADERSOURCEPROC real_glShaderSource;
+static void APIENTRY capture_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)
+{
+    real_glShaderSource(shader, count, string, length);
+    capture_call(58);
+    capture_u32((uint32_t) shader);
+    capture_sources(count, string, length);
+}
+
+static PFNGLUNIFORMBLOCKBINDINGPROC real_glUniformBlockBinding;
+static void APIENTRY capture_glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+    real_glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+    capture_call(59);
+    capture_u32((uint32_t) program);
+    capture_u32((uint32_t) uniformBlockIndex);
+    capture_u32((uint32_t) uniformBlockBinding);
+}
+
+static PFNGLUNIFORMMATRIX4FVPROC real_glUniformMatrix4fv;
+static void APIENTRY capture_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    real_glUniformMatrix4fv(location, count, transpose, value);
+    capture_call(60);
+    capture_u32((uint32_t) location);
+    capture_u32((uint32_t) count);
+    capture_u32((uint32_t) transpose);
+    capture_bytes(value, 16 * count * sizeof(GLfloat));
+}
+
+static PFNGLUNMAPBUFFERPROC real_glUnmapBuffer;
+static GLboolean APIENTRY capture_glUnmapBuffer(GLenum target)
+{
+    GLboolean result = real_glUnmapBuffer(target);
+    capture_call(61);
+    capture_u32((uint32_t) target);
+    return result;
+}
+
+static PFNGLUSEPROGRAMPROC real_glUseProgram;
+static void APIENTRY capture_glUseProgram(GLuint program)
+{
+    real_glUseProgram(program);
+    capture_call(62);
+    capture_u32((uint32_t) program);
+}
+
+static PFNGLVERTEXATTRIBDIVISORPROC real_glVertexAttribDivisor;
+static void APIENTRY capture_glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    real_glVertexAttribDivisor(index, divisor);
+    capture_call(63);
+    capture_u32((uint32_t) index);
+    capture_u32((uint32_t) divisor);
+}
+
+static PFNGLVERTEXATTRIBPOINTERPROC real_glVertexAttribPointer;
+static void APIENTRY capture_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+    real_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    capture_call(64);
+    capture_u32((uint32_t) index);
+    capture_u32((uint32_t) size);
+    capture_u32((uint32_t) type);
+    capture_u32((uint32_t) normalized);
+    capture_u32((uint32_t) stride);
+    capture_u64((uint64_t) (uintptr_t) pointer);
+}
+
+static PFNGLVIEWPORTPROC real_glViewport;
+static void APIENTRY capture_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    real_glViewport(x, y, width, height);
+    capture_call(65);
+    capture_u32((uint32_t) x);
+    capture_u32((uint32_t) y);
+    capture_u32((uint32_t) width);
+    capture_u32((uint32_t) height);
+}
+
+void gl_capture_hook(void)
+{
+    gl_loader_resolve_all();
+    real_glAttachShader = gl_loader_glAttachShader;
+    gl_loader_glAttachShader = capture_glAttachShader;
+    real_glBindBuffer = gl_loader_glBindBuffer;
+    gl_loader_glBindBuffer = capture_glBindBuffer;
+    real_glBindBufferRange = gl_loader_glBindBufferRange;
+    gl_loader_glBindBufferRange = capture_glBindBufferRange;
+    real_glBindFramebuffer = gl_loader_glBindFramebuffer;
+    gl_loader_glBindFramebuffer = capture_glBindFramebuffer;
+    real_glBindRenderbuffer = gl_loader_glBindRenderbuffer;
+    gl_loader_glBindRenderbuffer = capture_glBindRenderbuffer;
+    real_glBindVertexArray = gl_loader_glBindVertexArray;
+    gl_loader_glBindVertexArray = capture_glBindVertexArray;
+    real_glBufferData = gl_loader_glBufferData;
+    gl_loader_glBufferData = capture_glBufferData;
+    real_glBufferStorage = gl_loader_glBufferStorage;
+    gl_loader_glBufferStorage = capture_glBufferStorage;
+    real_glBufferSubData = gl_loader_glBufferSubData;
+    gl_loader_glBufferSubData = capture_glBufferSubData;
+    real_glCheckFramebufferStatus = gl_loader_glCheckFramebufferStatus;
+    gl_loader_glCheckFramebufferStatus = capture_glCheckFramebufferStatus;
+    real_glClear = gl_loader_glClear;
+    gl_loader_glClear = capture_glClear;
+    real_glClearColor = gl_loader_glClearColor;
+    gl_loader_glClearColor = capture_glClearColor;
+    real_glClientWaitSync = gl_loader_glClientWaitSync;
+    gl_loader_glClientWaitSync = capture_glClientWaitSync;
+    real_glCompileShader = gl_loader_glCompileShader;
+    gl_loader_glCompileShader = capture_glCompileShader;
+    real_glCopyBufferSubData = gl_loader_glCopyBufferSubData;
+    gl_loader_glCopyBufferSubData = capture_glCopyBufferSubData;
+    real_glCreateProgram = gl_loader_glCreateProgram;
+    gl_loader_glCreateProgram = capture_glCreateProgram;
+    real_glCreateShader = gl_loader_glCreateShader;
+    gl_loader_glCreateShader = capture_glCreateShader;
+    real_glDebugMessageCallback = gl_loader_glDebugMessageCallback;
+    gl_loader_glDebugMessageCallback = capture_glDebugMessageCallback;
+    real_glDebugMessageControl = gl_loader_glDebugMessageControl;
+    gl_loader_glDebugMessageControl = capture_glDebugMessageControl;
+    real_glDeleteBuffers = gl_loader_glDeleteBuffers;
+    gl_loader_glDeleteBuffers = capture_glDeleteBuffers;
+    real_glDeleteFramebuffers = gl_loader_glDeleteFramebuffers;
+    gl_loader_glDeleteFramebuffers = capture_glDeleteFramebuffers;
+    real_glDeleteProgram = gl_loader_glDeleteProgram;
+    gl_loader_glDeleteProgram = capture_glDeleteProgram;
+    real_glDeleteQueries = gl_loader_glDeleteQueries;
+    gl_loader_glDeleteQueries = capture_glDeleteQueries;
+    real_glDeleteRenderbuffers = gl_loader_glDeleteRenderbuffers;
+    gl_loader_glDeleteRenderbuffers = capture_glDeleteRenderbuffers;
+    real_glDeleteShader = gl_loader_glDeleteShader;
+    gl_loader_glDeleteShader = capture_glDeleteShader;
+    real_glDeleteSync = gl_loader_glDeleteSync;
+    gl_loader_glDeleteSync = capture_glDeleteSync;
+    real_glDeleteVertexArrays = gl_loader_glDeleteVertexArrays;
+    gl_loader_glDeleteVertexArrays = capture_glDeleteVertexArrays;
+    real_glDetachShader = gl_loader_glDetachShader;
+    gl_loader_glDetachShader = capture_glDetachShader;
+    real_glDrawElements = gl_loader_glDrawElements;
+    gl_loader_glDrawElements = capture_glDrawElements;
+    real_glEnable = gl_loader_glEnable;
+    gl_loader_glEnable = capture_glEnable;
+    real_glEnableVertexAttribArray = gl_loader_glEnableVertexAttribArray;
+    gl_loader_glEnableVertexAttribArray = capture_glEnableVertexAttribArray;
+    real_glFenceSync = gl_loader_glFenceSync;
+    gl_loader_glFenceSync = capture_glFenceSync;
+    real_glFinish = gl_loader_glFinish;
+    gl_loader_glFinish = capture_glFinish;
+    real_glFlushMappedBufferRange = gl_loader_glFlushMappedBufferRange;
+    gl_loader_glFlushMappedBufferRange = capture_glFlushMappedBufferRange;
+    real_glFramebufferRenderbuffer = gl_loader_glFramebufferRenderbuffer;
+    gl_loader_glFramebufferRenderbuffer = capture_glFramebufferRenderbuffer;
+    real_glGenBuffers = gl_loader_glGenBuffers;
+    gl_loader_glGenBuffers = capture_glGenBuffers;
+    real_glGenFramebuffers = gl_loader_glGenFramebuffers;
+    gl_loader_glGenFramebuffers = capture_glGenFramebuffers;
+    real_glGenQueries = gl_loader_glGenQueries;
+    gl_loader_glGenQueries = capture_glGenQueries;
+    real_glGenRenderbuffers = gl_loader_glGenRenderbuffers;
+    gl_loader_glGenRenderbuffers = capture_glGenRenderbuffers;
+    real_glGenVertexArrays = gl_loader_glGenVertexArrays;
+    gl_loader_glGenVertexArrays = capture_glGenVertexArrays;
+    real_glGetError = gl_loader_glGetError;
+    gl_loader_glGetError = capture_glGetError;
+    real_glGetInteger64v = gl_loader_glGetInteger64v;
+    gl_loader_glGetInteger64v = capture_glGetInteger64v;
+    real_glGetIntegerv = gl_loader_glGetIntegerv;
+    gl_loader_glGetIntegerv = capture_glGetIntegerv;
+    real_glGetProgramInfoLog = gl_loader_glGetProgramInfoLog;
+    gl_loader_glGetProgramInfoLog = capture_glGetProgramInfoLog;
+    real_glGetProgramiv = gl_loader_glGetProgramiv;
+    gl_loader_glGetProgramiv = capture_glGetProgramiv;
+    real_glGetQueryObjectiv = gl_loader_glGetQueryObjectiv;
+    gl_loader_glGetQueryObjectiv = capture_glGetQueryObjectiv;
+    real_glGetQueryObjectui64v = gl_loader_glGetQueryObjectui64v;
+    gl_loader_glGetQueryObjectui64v = capture_glGetQueryObjectui64v;
+    real_glGetShaderInfoLog = gl_loader_glGetShaderInfoLog;
+    gl_loader_glGetShaderInfoLog = capture_glGetShaderInfoLog;
+    real_glGetShaderiv = gl_loader_glGetShaderiv;
+    gl_loader_glGetShaderiv = capture_glGetShaderiv;
+    real_glGetString = gl_loader_glGetString;
+    gl_loader_glGetString = capture_glGetString;
+    real_glGetStringi = gl_loader_glGetStringi;
+    gl_loader_glGetStringi = capture_glGetStringi;
+    real_glGetUniformBlockIndex = gl_loader_glGetUniformBlockIndex;
+    gl_loader_glGetUniformBlockIndex = capture_glGetUniformBlockIndex;
+    real_glGetUniformLocation = gl_loader_glGetUniformLocation;
+    gl_loader_glGetUniformLocation = capture_glGetUniformLocation;
+    real_glLinkProgram = gl_loader_glLinkProgram;
+    gl_loader_glLinkProgram = capture_glLinkProgram;
+    real_glMapBufferRange = gl_loader_glMapBufferRange;
+    gl_loader_glMapBufferRange = capture_glMapBufferRange;
+    real_glObjectLabel = gl_loader_glObjectLabel;
+    gl_loader_glObjectLabel = capture_glObjectLabel;
+    real_glQueryCounter = gl_loader_glQueryCounter;
+    gl_loader_glQueryCounter = capture_glQueryCounter;
+    real_glRenderbufferStorage = gl_loader_glRenderbufferStorage;
+    gl_loader_glRenderbufferStorage = capture_glRenderbufferStorage;
+    real_glShaderSource = gl_loader_glShaderSource;
+    gl_loader_glShaderSource = capture_glShaderSource;
+    real_glUniformBlockBinding = gl_loader_glUniformBlockBinding;
+    gl_loader_glUniformBlockBinding = capture_glUniformBlockBinding;
+    real_glUniformMatrix4fv = gl_loader_glUniformMatrix4fv;
+    gl_loader_glUniformMatrix4fv = capture_glUniformMatrix4fv;
+    real_glUnmapBuffer = gl_loader_glUnmapBuffer;
+    gl_loader_glUnmapBuffer = capture_glUnmapBuffer;
+    real_glUseProgram = gl_loader_glUseProgram;
+    gl_loader_glUseProgram = capture_glUseProgram;
+    real_glVertexAttribDivisor = gl_loader_glVertexAttribDivisor;
+    gl_loader_glVertexAttribDivisor = capture_glVertexAttribDivisor;
+    real_glVertexAttribPointer = gl_loader_glVertexAttribPointer;
+    gl_loader_glVertexAttribPointer = capture_glVertexAttribPointer;
+    real_glViewport = gl_loader_glViewport;
+    gl_loader_glViewport = capture_glViewport;
+}
+
+void gl_capture_unhook(void)
+{
+    gl_loader_glAttachShader = real_glAttachShader;
+    gl_loader_glBindBuffer = real_glBindBuffer;
+    gl_loader_glBindBufferRange = real_glBindBufferRange;
+    gl_loader_glBindFramebuffer = real_glBindFramebuffer;
+    gl_loader_glBindRenderbuffer = real_glBindRenderbuffer;
+    gl_loader_glBindVertexArray = real_glBindVertexArray;
+    gl_loader_glBufferData = real_glBufferData;
+    gl_loader_glBufferStorage = real_glBufferStorage;
+    gl_loader_glBufferSubData = real_glBufferSubData;
+    gl_loader_glCheckFramebufferStatus = real_glCheckFramebufferStatus;
+    gl_loader_glClear = real_glClear;
+    gl_loader_glClearColor = real_glClearColor;
+    gl_loader_glClientWaitSync = real_glClientWaitSync;
+    gl_loader_glCompileShader = real_glCompileShader;
+    gl_loader_glCopyBufferSubData = real_glCopyBufferSubData;
+    gl_loader_glCreateProgram = real_glCreateProgram;
+    gl_loader_glCreateShader = real_glCreateShader;
+    gl_loader_glDebugMessageCallback = real_glDebugMessageCallback;
+    gl_loader_glDebugMessageControl = real_glDebugMessageControl;
+    gl_loader_glDeleteBuffers = real_glDeleteBuffers;
+    gl_loader_glDeleteFramebuffers = real_glDeleteFramebuffers;
+    gl_loader_glDeleteProgram = real_glDeleteProgram;
+    gl_loader_glDeleteQueries = real_glDeleteQueries;
+    gl_loader_glDeleteRenderbuffers = real_glDeleteRenderbuffers;
+    gl_loader_glDeleteShader = real_glDeleteShader;
+    gl_loader_glDeleteSync = real_glDeleteSync;
+    gl_loader_glDeleteVertexArrays = real_glDeleteVertexArrays;
+    gl_loader_glDetachShader = real_glDetachShader;
+    gl_loader_glDrawElements = real_glDrawElements;
+    gl_loader_glEnable = real_glEnable;
+    gl_loader_glEnableVertexAttribArray = real_glEnableVertexAttribArray;
+    gl_loader_glFenceSync = real_glFenceSync;
+    gl_loader_glFinish = real_glFinish;
+    gl_loader_glFlushMappedBufferRange = real_glFlushMappedBufferRange;
+    gl_loader_glFramebufferRenderbuffer = real_glFramebufferRenderbuffer;
+    gl_loader_glGenBuffers = real_glGenBuffers;
+    gl_loader_glGenFramebuffers = real_glGenFramebuffers;
+    gl_loader_glGenQueries = real_glGenQueries;
+    gl_loader_glGenRenderbuffers = real_glGenRenderbuffers;
+    gl_loader_glGenVertexArrays = real_glGenVertexArrays;
+    gl_loader_glGetError = real_glGetError;
+    gl_loader_glGetInteger64v = real_glGetInteger64v;
+    gl_loader_glGetIntegerv = real_glGetIntegerv;
+    gl_loader_glGetProgramInfoLog = real_glGetProgramInfoLog;
+    gl_loader_glGetProgramiv = real_glGetProgramiv;
+    gl_loader_glGetQueryObjectiv = real_glGetQueryObjectiv;
+    gl_loader_glGetQueryObjectui64v = real_glGetQueryObjectui64v;
+    gl_loader_glGetShaderInfoLog = real_glGetShaderInfoLog;
+    gl_loader_glGetShaderiv = real_glGetShaderiv;
+    gl_loader_glGetString = real_glGetString;
+    gl_loader_glGetStringi = real_glGetStringi;
+    gl_loader_glGetUniformBlockIndex = real_glGetUniformBlockIndex;
+    gl_loader_glGetUniformLocation = real_glGetUniformLocation;
+    gl_loader_glLinkProgram = real_glLinkProgram;
+    gl_loader_glMapBufferRange = real_glMapBufferRange;
+    gl_loader_glObjectLabel = real_glObjectLabel;
+    gl_loader_glQueryCounter = real_glQueryCounter;
+    gl_loader_glRenderbufferStorage = real_glRenderbufferStorage;
+    gl_loader_glShaderSource = real_glShaderSource;
+    gl_loader_glUniformBlockBinding = real_glUniformBlockBinding;
+    gl_loader_glUniformMatrix4fv = real_glUniformMatrix4fv;
+    gl_loader_glUnmapBuffer = real_glUnmapBuffer;
+    gl_loader_glUseProgram = real_glUseProgram;
+    gl_loader_glVertexAttribDivisor = real_glVertexAttribDivisor;
+    gl_loader_glVertexAttribPointer = real_glVertexAttribPointer;
+    gl_loader_glViewport = real_glViewport;
+}
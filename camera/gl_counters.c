@@ -0,0 +1,752 @@
+/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */
+#include "gl_debug.h"
+
+#ifdef GL_COUNTERS
+unsigned long gl_counters[66];
+
+static PFNGLATTACHSHADERPROC next_glAttachShader;
+static PFNGLBINDBUFFERPROC next_glBindBuffer;
+static PFNGLBINDBUFFERRANGEPROC next_glBindBufferRange;
+static PFNGLBINDFRAMEBUFFERPROC next_glBindFramebuffer;
+static PFNGLBINDRENDERBUFFERPROC next_glBindRenderbuffer;
+static PFNGLBINDVERTEXARRAYPROC next_glBindVertexArray;
+static PFNGLBUFFERDATAPROC next_glBufferData;
+static PFNGLBUFFERSTORAGEPROC next_glBufferStorage;
+static PFNGLBUFFERSUBDATAPROC next_glBufferSubData;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC next_glCheckFramebufferStatus;
+static PFNGLCLEARPROC next_glClear;
+static PFNGLCLEARCOLORPROC next_glClearColor;
+static PFNGLCLIENTWAITSYNCPROC next_glClientWaitSync;
+static PFNGLCOMPILESHADERPROC next_glCompileShader;
+static PFNGLCOPYBUFFERSUBDATAPROC next_glCopyBufferSubData;
+static PFNGLCREATEPROGRAMPROC next_glCreateProgram;
+static PFNGLCREATESHADERPROC next_glCreateShader;
+static PFNGLDEBUGMESSAGECALLBACKPROC next_glDebugMessageCallback;
+static PFNGLDEBUGMESSAGECONTROLPROC next_glDebugMessageControl;
+static PFNGLDELETEBUFFERSPROC next_glDeleteBuffers;
+static PFNGLDELETEFRAMEBUFFERSPROC next_glDeleteFramebuffers;
+static PFNGLDELETEPROGRAMPROC next_glDeleteProgram;
+static PFNGLDELETEQUERIESPROC next_glDeleteQueries;
+static PFNGLDELETERENDERBUFFERSPROC next_glDeleteRenderbuffers;
+static PFNGLDELETESHADERPROC next_glDeleteShader;
+static PFNGLDELETESYNCPROC next_glDeleteSync;
+static PFNGLDELETEVERTEXARRAYSPROC next_glDeleteVertexArrays;
+static PFNGLDETACHSHADERPROC next_glDetachShader;
+static PFNGLDRAWELEMENTSPROC next_glDrawElements;
+static PFNGLENABLEPROC next_glEnable;
+static PFNGLENABLEVERTEXATTRIBARRAYPROC next_glEnableVertexAttribArray;
+static PFNGLFENCESYNCPROC next_glFenceSync;
+static PFNGLFINISHPROC next_glFinish;
+static PFNGLFLUSHMAPPEDBUFFERRANGEPROC next_glFlushMappedBufferRange;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC next_glFramebufferRenderbuffer;
+static PFNGLGENBUFFERSPROC next_glGenBuffers;
+static PFNGLGENFRAMEBUFFERSPROC next_glGenFramebuffers;
+static PFNGLGENQUERIESPROC next_glGenQueries;
+static PFNGLGENRENDERBUFFERSPROC next_glGenRenderbuffers;
+static PFNGLGENVERTEXARRAYSPROC next_glGenVertexArrays;
+static PFNGLGETERRORPROC next_glGetError;
+static PFNGLGETINTEGER64VPROC next_glGetInteger64v;
+static PFNGLGETINTEGERVPROC next_glGetIntegerv;
+static PFNGLGETPROGRAMINFOLOGPROC next_glGetProgramInfoLog;
+static PFNGLGETPROGRAMIVPROC next_glGetProgramiv;
+static PFNGLGETQUERYOBJECTIVPROC next_glGetQueryObjectiv;
+static PFNGLGETQUERYOBJECTUI64VPROC next_glGetQueryObjectui64v;
+static PFNGLGETSHADERINFOLOGPROC next_glGetShaderInfoLog;
+static PFNGLGETSHADERIVPROC next_glGetShaderiv;
+static PFNGLGETSTRINGPROC next_glGetString;
+static PFNGLGETSTRINGIPROC next_glGetStringi;
+static PFNGLGETUNIFORMBLOCKINDEXPROC next_glGetUniformBlockIndex;
+static PFNGLGETUNIFORMLOCATIONPROC next_glGetUniformLocation;
+static PFNGLLINKPROGRAMPROC next_glLinkProgram;
+static PFNGLMAPBUFFERRANGEPROC next_glMapBufferRange;
+static PFNGLOBJECTLABELPROC next_glObjectLabel;
+static PFNGLQUERYCOUNTERPROC next_glQueryCounter;
+static PFNGLRENDERBUFFERSTORAGEPROC next_glRenderbufferStorage;
+static PFNGLSHADERSOURCEPROC next_glShaderSource;
+static PFNGLUNIFORMBLOCKBINDINGPROC next_glUniformBlockBinding;
+static PFNGLUNIFORMMATRIX4FVPROC next_glUniformMatrix4fv;
+static PFNGLUNMAPBUFFERPROC next_glUnmapBuffer;
+static PFNGLUSEPROGRAMPROC next_glUseProgram;
+static PFNGLVERTEXATTRIBDIVISORPROC next_glVertexAttribDivisor;
+static PFNGLVERTEXATTRIBPOINTERPROC next_glVertexAttribPointer;
+static PFNGLVIEWPORTPROC next_glViewport;
+
+static void APIENTRY count_glAttachShader(GLuint program, GLuint shader)
+{
+    gl_counters[0]++;
+    next_glAttachShader(program, shader);
+    if (gl_debug_poll_errors)
+        gl_debug_error(0, next_glGetError());
+}
+
+static void APIENTRY count_glBindBuffer(GLenum target, GLuint buffer)
+{
+    gl_counters[1]++;
+    next_glBindBuffer(target, buffer);
+    if (gl_debug_poll_errors)
+        gl_debug_error(1, next_glGetError());
+}
+
+static void APIENTRY count_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    gl_counters[2]++;
+    next_glBindBufferRange(target, index, buffer, offset, size);
+    if (gl_debug_poll_errors)
+        gl_debug_error(2, next_glGetError());
+}
+
+static void APIENTRY count_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    gl_counters[3]++;
+    next_glBindFramebuffer(target, framebuffer);
+    if (gl_debug_poll_errors)
+        gl_debug_error(3, next_glGetError());
+}
+
+static void APIENTRY count_glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    gl_counters[4]++;
+    next_glBindRenderbuffer(target, renderbuffer);
+    if (gl_debug_poll_errors)
+        gl_debug_error(4, next_glGetError());
+}
+
+static void APIENTRY count_glBindVertexArray(GLuint array)
+{
+    gl_counters[5]++;
+    next_glBindVertexArray(array);
+    if (gl_debug_poll_errors)
+        gl_debug_error(5, next_glGetError());
+}
+
+static void APIENTRY count_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    gl_counters[6]++;
+    next_glBufferData(target, size, data, usage);
+    if (gl_debug_poll_errors)
+        gl_debug_error(6, next_glGetError());
+}
+
+static void APIENTRY count_glBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    gl_counters[7]++;
+    next_glBufferStorage(target, size, data, flags);
+    if (gl_debug_poll_errors)
+        gl_debug_error(7, next_glGetError());
+}
+
+static void APIENTRY count_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    gl_counters[8]++;
+    next_glBufferSubData(target, offset, size, data);
+    if (gl_debug_poll_errors)
+        gl_debug_error(8, next_glGetError());
+}
+
+static GLenum APIENTRY count_glCheckFramebufferStatus(GLenum target)
+{
+    gl_counters[9]++;
+    GLenum result = next_glCheckFramebufferStatus(target);
+    if (gl_debug_poll_errors)
+        gl_debug_error(9, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glClear(GLbitfield mask)
+{
+    gl_counters[10]++;
+    next_glClear(mask);
+    if (gl_debug_poll_errors)
+        gl_debug_error(10, next_glGetError());
+}
+
+static void APIENTRY count_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    gl_counters[11]++;
+    next_glClearColor(red, green, blue, alpha);
+    if (gl_debug_poll_errors)
+        gl_debug_error(11, next_glGetError());
+}
+
+static GLenum APIENTRY count_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    gl_counters[12]++;
+    GLenum result = next_glClientWaitSync(sync, flags, timeout);
+    if (gl_debug_poll_errors)
+        gl_debug_error(12, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glCompileShader(GLuint shader)
+{
+    gl_counters[13]++;
+    next_glCompileShader(shader);
+    if (gl_debug_poll_errors)
+        gl_debug_error(13, next_glGetError());
+}
+
+static void APIENTRY count_glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    gl_counters[14]++;
+    next_glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+    if (gl_debug_poll_errors)
+        gl_debug_error(14, next_glGetError());
+}
+
+static GLuint APIENTRY count_glCreateProgram(void)
+{
+    gl_counters[15]++;
+    GLuint result = next_glCreateProgram();
+    if (gl_debug_poll_errors)
+        gl_debug_error(15, next_glGetError());
+    return result;
+}
+
+static GLuint APIENTRY count_glCreateShader(GLenum type)
+{
+    gl_counters[16]++;
+    GLuint result = next_glCreateShader(type);
+    if (gl_debug_poll_errors)
+        gl_debug_error(16, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam)
+{
+    gl_counters[17]++;
+    next_glDebugMessageCallback(callback, userParam);
+    if (gl_debug_poll_errors)
+        gl_debug_error(17, next_glGetError());
+}
+
+static void APIENTRY count_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled)
+{
+    gl_counters[18]++;
+    next_glDebugMessageControl(source, type, severity, count, ids, enabled);
+    if (gl_debug_poll_errors)
+        gl_debug_error(18, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    gl_counters[19]++;
+    next_glDeleteBuffers(n, buffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(19, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    gl_counters[20]++;
+    next_glDeleteFramebuffers(n, framebuffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(20, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteProgram(GLuint program)
+{
+    gl_counters[21]++;
+    next_glDeleteProgram(program);
+    if (gl_debug_poll_errors)
+        gl_debug_error(21, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteQueries(GLsizei n, const GLuint *ids)
+{
+    gl_counters[22]++;
+    next_glDeleteQueries(n, ids);
+    if (gl_debug_poll_errors)
+        gl_debug_error(22, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+    gl_counters[23]++;
+    next_glDeleteRenderbuffers(n, renderbuffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(23, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteShader(GLuint shader)
+{
+    gl_counters[24]++;
+    next_glDeleteShader(shader);
+    if (gl_debug_poll_errors)
+        gl_debug_error(24, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteSync(GLsync sync)
+{
+    gl_counters[25]++;
+    next_glDeleteSync(sync);
+    if (gl_debug_poll_errors)
+        gl_debug_error(25, next_glGetError());
+}
+
+static void APIENTRY count_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    gl_counters[26]++;
+    next_glDeleteVertexArrays(n, arrays);
+    if (gl_debug_poll_errors)
+        gl_debug_error(26, next_glGetError());
+}
+
+static void APIENTRY count_glDetachShader(GLuint program, GLuint shader)
+{
+    gl_counters[27]++;
+    next_glDetachShader(program, shader);
+    if (gl_debug_poll_errors)
+        gl_debug_error(27, next_glGetError());
+}
+
+static void APIENTRY count_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    gl_counters[28]++;
+    next_glDrawElements(mode, count, type, indices);
+    if (gl_debug_poll_errors)
+        gl_debug_error(28, next_glGetError());
+}
+
+static void APIENTRY count_glEnable(GLenum cap)
+{
+    gl_counters[29]++;
+    next_glEnable(cap);
+    if (gl_debug_poll_errors)
+        gl_debug_error(29, next_glGetError());
+}
+
+static void APIENTRY count_glEnableVertexAttribArray(GLuint index)
+{
+    gl_counters[30]++;
+    next_glEnableVertexAttribArray(index);
+    if (gl_debug_poll_errors)
+        gl_debug_error(30, next_glGetError());
+}
+
+static GLsync APIENTRY count_glFenceSync(GLenum condition, GLbitfield flags)
+{
+    gl_counters[31]++;
+    GLsync result = next_glFenceSync(condition, flags);
+    if (gl_debug_poll_errors)
+        gl_debug_error(31, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glFinish(void)
+{
+    gl_counters[32]++;
+    next_glFinish();
+    if (gl_debug_poll_errors)
+        gl_debug_error(32, next_glGetError());
+}
+
+static void APIENTRY count_glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    gl_counters[33]++;
+    next_glFlushMappedBufferRange(target, offset, length);
+    if (gl_debug_poll_errors)
+        gl_debug_error(33, next_glGetError());
+}
+
+static void APIENTRY count_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    gl_counters[34]++;
+    next_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    if (gl_debug_poll_errors)
+        gl_debug_error(34, next_glGetError());
+}
+
+static void APIENTRY count_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+    gl_counters[35]++;
+    next_glGenBuffers(n, buffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(35, next_glGetError());
+}
+
+static void APIENTRY count_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+    gl_counters[36]++;
+    next_glGenFramebuffers(n, framebuffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(36, next_glGetError());
+}
+
+static void APIENTRY count_glGenQueries(GLsizei n, GLuint *ids)
+{
+    gl_counters[37]++;
+    next_glGenQueries(n, ids);
+    if (gl_debug_poll_errors)
+        gl_debug_error(37, next_glGetError());
+}
+
+static void APIENTRY count_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+    gl_counters[38]++;
+    next_glGenRenderbuffers(n, renderbuffers);
+    if (gl_debug_poll_errors)
+        gl_debug_error(38, next_glGetError());
+}
+
+static void APIENTRY count_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+    gl_counters[39]++;
+    next_glGenVertexArrays(n, arrays);
+    if (gl_debug_poll_errors)
+        gl_debug_error(39, next_glGetError());
+}
+
+static GLenum APIENTRY count_glGetError(void)
+{
+    gl_counters[40]++;
+    GLenum result = next_glGetError();
+    return result;
+}
+
+static void APIENTRY count_glGetInteger64v(GLenum pname, GLint64 *data)
+{
+    gl_counters[41]++;
+    next_glGetInteger64v(pname, data);
+    if (gl_debug_poll_errors)
+        gl_debug_error(41, next_glGetError());
+}
+
+static void APIENTRY count_glGetIntegerv(GLenum pname, GLint *data)
+{
+    gl_counters[42]++;
+    next_glGetIntegerv(pname, data);
+    if (gl_debug_poll_errors)
+        gl_debug_error(42, next_glGetError());
+}
+
+static void APIENTRY count_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    gl_counters[43]++;
+    next_glGetProgramInfoLog(program, bufSize, length, infoLog);
+    if (gl_debug_poll_errors)
+        gl_debug_error(43, next_glGetError());
+}
+
+static void APIENTRY count_glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+    gl_counters[44]++;
+    next_glGetProgramiv(program, pname, params);
+    if (gl_debug_poll_errors)
+        gl_debug_error(44, next_glGetError());
+}
+
+static void APIENTRY count_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params)
+{
+    gl_counters[45]++;
+    next_glGetQueryObjectiv(id, pname, params);
+    if (gl_debug_poll_errors)
+        gl_debug_error(45, next_glGetError());
+}
+
+static void APIENTRY count_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+    gl_counters[46]++;
+    next_glGetQueryObjectui64v(id, pname, params);
+    if (gl_debug_poll_errors)
+        gl_debug_error(46, next_glGetError());
+}
+
+static void APIENTRY count_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    gl_counters[47]++;
+    next_glGetShaderInfoLog(shader, bufSize, length, infoLog);
+    if (gl_debug_poll_errors)
+        gl_debug_error(47, next_glGetError());
+}
+
+static void APIENTRY count_glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+    gl_counters[48]++;
+    next_glGetShaderiv(shader, pname, params);
+    if (gl_debug_poll_errors)
+        gl_debug_error(48, next_glGetError());
+}
+
+static const GLubyte * APIENTRY count_glGetString(GLenum name)
+{
+    gl_counters[49]++;
+    const GLubyte * result = next_glGetString(name);
+    if (gl_debug_poll_errors)
+        gl_debug_error(49, next_glGetError());
+    return result;
+}
+
+static const GLubyte * APIENTRY count_glGetStringi(GLenum name, GLuint index)
+{
+    gl_counters[50]++;
+    const GLubyte * result = next_glGetStringi(name, index);
+    if (gl_debug_poll_errors)
+        gl_debug_error(50, next_glGetError());
+    return result;
+}
+
+static GLuint APIENTRY count_glGetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+    gl_counters[51]++;
+    GLuint result = next_glGetUniformBlockIndex(program, uniformBlockName);
+    if (gl_debug_poll_errors)
+        gl_debug_error(51, next_glGetError());
+    return result;
+}
+
+static GLint APIENTRY count_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+    gl_counters[52]++;
+    GLint result = next_glGetUniformLocation(program, name);
+    if (gl_debug_poll_errors)
+        gl_debug_error(52, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glLinkProgram(GLuint program)
+{
+    gl_counters[53]++;
+    next_glLinkProgram(program);
+    if (gl_debug_poll_errors)
+        gl_debug_error(53, next_glGetError());
+}
+
+static void * APIENTRY count_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    gl_counters[54]++;
+    void * result = next_glMapBufferRange(target, offset, length, access);
+    if (gl_debug_poll_errors)
+        gl_debug_error(54, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glObjectLabel(GLenum identifier, GLuint name, GLsizei length, const GLchar *label)
+{
+    gl_counters[55]++;
+    next_glObjectLabel(identifier, name, length, label);
+    if (gl_debug_poll_errors)
+        gl_debug_error(55, next_glGetError());
+}
+
+static void APIENTRY count_glQueryCounter(GLuint id, GLenum target)
+{
+    gl_counters[56]++;
+    next_glQueryCounter(id, target);
+    if (gl_debug_poll_errors)
+        gl_debug_error(56, next_glGetError());
+}
+
+static void APIENTRY count_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    gl_counters[57]++;
+    next_glRenderbufferStorage(target, internalformat, width, height);
+    if (gl_debug_poll_errors)
+        gl_debug_error(57, next_glGetError());
+}
+
+static void APIENTRY count_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)
+{
+    gl_counters[58]++;
+    next_glShaderSource(shader, count, string, length);
+    if (gl_debug_poll_errors)
+        gl_debug_error(58, next_glGetError());
+}
+
+static void APIENTRY count_glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+    gl_counters[59]++;
+    next_glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+    if (gl_debug_poll_errors)
+        gl_debug_error(59, next_glGetError());
+}
+
+static void APIENTRY count_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    gl_counters[60]++;
+    next_glUniformMatrix4fv(location, count, transpose, value);
+    if (gl_debug_poll_errors)
+        gl_debug_error(60, next_glGetError());
+}
+
+static GLboolean APIENTRY count_glUnmapBuffer(GLenum target)
+{
+    gl_counters[61]++;
+    GLboolean result = next_glUnmapBuffer(target);
+    if (gl_debug_poll_errors)
+        gl_debug_error(61, next_glGetError());
+    return result;
+}
+
+static void APIENTRY count_glUseProgram(GLuint program)
+{
+    gl_counters[62]++;
+    next_glUseProgram(program);
+    if (gl_debug_poll_errors)
+        gl_debug_error(62, next_glGetError());
+}
+
+static void APIENTRY count_glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    gl_counters[63]++;
+    next_glVertexAttribDivisor(index, divisor);
+    if (gl_debug_poll_errors)
+        gl_debug_error(63, next_glGetError());
+}
+
+static void APIENTRY count_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+    gl_counters[64]++;
+    next_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    if (gl_debug_poll_errors)
+        gl_debug_error(64, next_glGetError());
+}
+
+static void APIENTRY count_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    gl_counters[65]++;
+    next_glViewport(x, y, width, height);
+    if (gl_debug_poll_errors)
+        gl_debug_error(65, next_glGetError());
+}
+
+void gl_counters_hook(void)
+{
+    static bool hooked;
+    if (hooked)
+        return;
+    hooked = true;
+    gl_loader_resolve_all();
+    next_glAttachShader = gl_loader_glAttachShader;
+    gl_loader_glAttachShader = count_glAttachShader;
+    next_glBindBuffer = gl_loader_glBindBuffer;
+    gl_loader_glBindBuffer = count_glBindBuffer;
+    next_glBindBufferRange = gl_loader_glBindBufferRange;
+    gl_loader_glBindBufferRange = count_glBindBufferRange;
+    next_glBindFramebuffer = gl_loader_glBindFramebuffer;
+    gl_loader_glBindFramebuffer = count_glBindFramebuffer;
+    next_glBindRenderbuffer = gl_loader_glBindRenderbuffer;
+    gl_loader_glBindRenderbuffer = count_glBindRenderbuffer;
+    next_glBindVertexArray = gl_loader_glBindVertexArray;
+    gl_loader_glBindVertexArray = count_glBindVertexArray;
+    next_glBufferData = gl_loader_glBufferData;
+    gl_loader_glBufferData = count_glBufferData;
+    next_glBufferStorage = gl_loader_glBufferStorage;
+    gl_loader_glBufferStorage = count_glBufferStorage;
+    next_glBufferSubData = gl_loader_glBufferSubData;
+    gl_loader_glBufferSubData = count_glBufferSubData;
+    next_glCheckFramebufferStatus = gl_loader_glCheckFramebufferStatus;
+    gl_loader_glCheckFramebufferStatus = count_glCheckFramebufferStatus;
+    next_glClear = gl_loader_glClear;
+    gl_loader_glClear = count_glClear;
+    next_glClearColor = gl_loader_glClearColor;
+    gl_loader_glClearColor = count_glClearColor;
+    next_glClientWaitSync = gl_loader_glClientWaitSync;
+    gl_loader_glClientWaitSync = count_glClientWaitSync;
+    next_glCompileShader = gl_loader_glCompileShader;
+    gl_loader_glCompileShader = count_glCompileShader;
+    next_glCopyBufferSubData = gl_loader_glCopyBufferSubData;
+    gl_loader_glCopyBufferSubData = count_glCopyBufferSubData;
+    next_glCreateProgram = gl_loader_glCreateProgram;
+    gl_loader_glCreateProgram = count_glCreateProgram;
+    next_glCreateShader = gl_loader_glCreateShader;
+    gl_loader_glCreateShader = count_glCreateShader;
+    next_glDebugMessageCallback = gl_loader_glDebugMessageCallback;
+    gl_loader_glDebugMessageCallback = count_glDebugMessageCallback;
+    next_glDebugMessageControl = gl_loader_glDebugMessageControl;
+    gl_loader_glDebugMessageControl = count_glDebugMessageControl;
+    next_glDeleteBuffers = gl_loader_glDeleteBuffers;
+    gl_loader_glDeleteBuffers = count_glDeleteBuffers;
+    next_glDeleteFramebuffers = gl_loader_glDeleteFramebuffers;
+    gl_loader_glDeleteFramebuffers = count_glDeleteFramebuffers;
+    next_glDeleteProgram = gl_loader_glDeleteProgram;
+    gl_loader_glDeleteProgram = count_glDeleteProgram;
+    next_glDeleteQueries = gl_loader_glDeleteQueries;
+    gl_loader_glDeleteQueries = count_glDeleteQueries;
+    next_glDeleteRenderbuffers = gl_loader_glDeleteRenderbuffers;
+    gl_loader_glDeleteRenderbuffers = count_glDeleteRenderbuffers;
+    next_glDeleteShader = gl_loader_glDeleteShader;
+    gl_loader_glDeleteShader = count_glDeleteShader;
+    next_glDeleteSync = gl_loader_glDeleteSync;
+    gl_loader_glDeleteSync = count_glDeleteSync;
+    next_glDeleteVertexArrays = gl_loader_glDeleteVertexArrays;
+    gl_loader_glDeleteVertexArrays = count_glDeleteVertexArrays;
+    next_glDetachShader = gl_loader_glDetachShader;
+    gl_loader_glDetachShader = count_glDetachShader;
+    next_glDrawElements = gl_loader_glDrawElements;
+    gl_loader_glDrawElements = count_glDrawElements;
+    next_glEnable = gl_loader_glEnable;
+    gl_loader_glEnable = count_glEnable;
+    next_glEnableVertexAttribArray = gl_loader_glEnableVertexAttribArray;
+    gl_loader_glEnableVertexAttribArray = count_glEnableVertexAttribArray;
+    next_glFenceSync = gl_loader_glFenceSync;
+    gl_loader_glFenceSync = count_glFenceSync;
+    next_glFinish = gl_loader_glFinish;
+    gl_loader_glFinish = count_glFinish;
+    next_glFlushMappedBufferRange = gl_loader_glFlushMappedBufferRange;
+    gl_loader_glFlushMappedBufferRange = count_glFlushMappedBufferRange;
+    next_glFramebufferRenderbuffer = gl_loader_glFramebufferRenderbuffer;
+    gl_loader_glFramebufferRenderbuffer = count_glFramebufferRenderbuffer;
+    next_glGenBuffers = gl_loader_glGenBuffers;
+    gl_loader_glGenBuffers = count_glGenBuffers;
+    next_glGenFramebuffers = gl_loader_glGenFramebuffers;
+    gl_loader_glGenFramebuffers = count_glGenFramebuffers;
+    next_glGenQueries = gl_loader_glGenQueries;
+    gl_loader_glGenQueries = count_glGenQueries;
+    next_glGenRenderbuffers = gl_loader_glGenRenderbuffers;
+    gl_loader_glGenRenderbuffers = count_glGenRenderbuffers;
+    next_glGenVertexArrays = gl_loader_glGenVertexArrays;
+    gl_loader_glGenVertexArrays = count_glGenVertexArrays;
+    next_glGetError = gl_loader_glGetError;
+    gl_loader_glGetError = count_glGetError;
+    next_glGetInteger64v = gl_loader_glGetInteger64v;
+    gl_loader_glGetInteger64v = count_glGetInteger64v;
+    next_glGetIntegerv = gl_loader_glGetIntegerv;
+    gl_loader_glGetIntegerv = count_glGetIntegerv;
+    next_glGetProgramInfoLog = gl_loader_glGetProgramInfoLog;
+    gl_loader_glGetProgramInfoLog = count_glGetProgramInfoLog;
+    next_glGetProgramiv = gl_loader_glGetProgramiv;
+    gl_loader_glGetProgramiv = count_glGetProgramiv;
+    next_glGetQueryObjectiv = gl_loader_glGetQueryObjectiv;
+    gl_loader_glGetQueryObjectiv = count_glGetQueryObjectiv;
+    next_glGetQueryObjectui64v = gl_loader_glGetQueryObjectui64v;
+    gl_loader_glGetQueryObjectui64v = count_glGetQueryObjectui64v;
+    next_glGetShaderInfoLog = gl_loader_glGetShaderInfoLog;
+    gl_loader_glGetShaderInfoLog = count_glGetShaderInfoLog;
+    next_glGetShaderiv = gl_loader_glGetShaderiv;
+    gl_loader_glGetShaderiv = count_glGetShaderiv;
+    next_glGetString = gl_loader_glGetString;
+    gl_loader_glGetString = count_glGetString;
+    next_glGetStringi = gl_loader_glGetStringi;
+    gl_loader_glGetStringi = count_glGetStringi;
+    next_glGetUniformBlockIndex = gl_loader_glGetUniformBlockIndex;
+    gl_loader_glGetUniformBlockIndex = count_glGetUniformBlockIndex;
+    next_glGetUniformLocation = gl_loader_glGetUniformLocation;
+    gl_loader_glGetUniformLocation = count_glGetUniformLocation;
+    next_glLinkProgram = gl_loader_glLinkProgram;
+    gl_loader_glLinkProgram = count_glLinkProgram;
+    next_glMapBufferRange = gl_loader_glMapBufferRange;
+    gl_loader_glMapBufferRange = count_glMapBufferRange;
+    next_glObjectLabel = gl_loader_glObjectLabel;
+    gl_loader_glObjectLabel = count_glObjectLabel;
+    next_glQueryCounter = gl_loader_glQueryCounter;
+    gl_loader_glQueryCounter = count_glQueryCounter;
+    next_glRenderbufferStorage = gl_loader_glRenderbufferStorage;
+    gl_loader_glRenderbufferStorage = count_glRenderbufferStorage;
+    next_glShaderSource = gl_loader_glShaderSource;
+    gl_loader_glShaderSource = count_glShaderSource;
+    next_glUniformBlockBinding = gl_loader_glUniformBlockBinding;
+    gl_loader_glUniformBlockBinding = count_glUniformBlockBinding;
+    next_glUniformMatrix4fv = gl_loader_glUniformMatrix4fv;
+    gl_loader_glUniformMatrix4fv = count_glUniformMatrix4fv;
+    next_glUnmapBuffer = gl_loader_glUnmapBuffer;
+    gl_loader_glUnmapBuffer = count_glUnmapBuffer;
+    next_glUseProgram = gl_loader_glUseProgram;
+    gl_loader_glUseProgram = count_glUseProgram;
+    next_glVertexAttribDivisor = gl_loader_glVertexAttribDivisor;
+    gl_loader_glVertexAttribDivisor = count_glVertexAttribDivisor;
+    next_glVertexAttribPointer = gl_loader_glVertexAttribPointer;
+    gl_loader_glVertexAttribPointer = count_glVertexAttribPointer;
+    next_glViewport = gl_loader_glViewport;
+    gl_loader_glViewport = count_glViewport;
+}
+#endif
@@ -0,0 +1,173 @@
+#include "gl_debug.h"
+
+#ifdef GL_DEBUG
+#include "log.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t key;               /* 0 marks a free slot */
+    unsigned long repeats;      /* since the last report */
+    char text[96];
+} DebugMessage;
+
+bool gl_debug_poll_errors;
+static bool has_khr_debug;
+static DebugMessage messages[GL_DEBUG_MAX_MESSAGES];
+static unsigned int message_count;
+static unsigned long frames;
+
+static uint64_t hash(uint64_t h, const void *data, size_t size)
+{
+    const unsigned char *p = data;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * UINT64_C(0x100000001b3);
+    return h;
+}
+
+/* Returns true the first time a message is seen. Once the table is full,
+ * new messages are always logged. */
+static bool first_time(uint64_t key, const char *text)
+{
+    key |= 1;
+    for (unsigned int i = 0, s = key % GL_DEBUG_MAX_MESSAGES; i < GL_DEBUG_MAX_MESSAGES;
+         i++, s = (s + 1) % GL_DEBUG_MAX_MESSAGES) {
+        DebugMessage *m = &messages[s];
+        if (m->key == key) {
+            m->repeats++;
+            return false;
+        }
+        if (!m->key) {
+            m->key = key;
+            snprintf(m->text, sizeof(m->text), "%s", text);
+            message_count++;
+            return true;
+        }
+    }
+    return true;
+}
+
+static const char *type_name(GLenum type)
+{
+    switch (type) {
+    case GL_DEBUG_TYPE_ERROR:
+        return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
+        return "deprecated";
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
+        return "undefined behavior";
+    case GL_DEBUG_TYPE_PORTABILITY:
+        return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE:
+        return "performance";
+    default:
+        return "other";
+    }
+}
+
+static void APIENTRY on_message(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                GLsizei length, const GLchar *message, const void *user)
+{
+    (void) user;
+    uint64_t key = hash(UINT64_C(0xcbf29ce484222325), &source, sizeof(source));
+    key = hash(key, &type, sizeof(type));
+    key = hash(key, &id, sizeof(id));
+    key = hash(key, message, length >= 0 ? (size_t) length : strlen(message));
+    if (!first_time(key, message))
+        return;
+
+    int level = LOG_DEBUG;
+    if (type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH)
+        level = LOG_ERROR;
+    else if (type == GL_DEBUG_TYPE_PERFORMANCE || severity == GL_DEBUG_SEVERITY_MEDIUM)
+        level = LOG_WARN;
+    else if (severity == GL_DEBUG_SEVERITY_LOW)
+        level = LOG_INFO;
+    log_log(level, __FILE__, __LINE__, "gl %s %u: %s", type_name(type), id, message);
+}
+
+void gl_debug_init(void)
+{
+    has_khr_debug = gl_loader_has(GL_LOADER_KHR_debug);
+    if (has_khr_debug) {
+        glEnable(GL_DEBUG_OUTPUT);
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(on_message, NULL);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+    } else {
+        gl_debug_poll_errors = true;
+    }
+    gl_counters_hook();
+    log_info("gl_debug: %s, counting calls", has_khr_debug ? "KHR_debug output" : "polling glGetError");
+}
+
+void gl_debug_error(unsigned int id, GLenum error)
+{
+    if (error == GL_NO_ERROR)
+        return;
+    char text[96];
+    snprintf(text, sizeof(text), "0x%04x in %s", error, gl_loader_names[id]);
+    if (first_time(hash(UINT64_C(0xcbf29ce484222325), text, strlen(text)), text))
+        log_error("gl error %s", text);
+}
+
+void gl_debug_frame(void)
+{
+    frames++;
+}
+
+/* Calls per frame since the last report, busiest entry points first, then
+ * how often already-logged messages repeated. */
+void gl_debug_report(void)
+{
+    if (!frames)
+        return;
+
+    unsigned long total = 0;
+    unsigned int top[GL_DEBUG_TOP];
+    int count = 0;
+    for (unsigned int i = 0; i < gl_loader_count; i++) {
+        total += gl_counters[i];
+        if (!gl_counters[i])
+            continue;
+        int at = count;
+        if (count < GL_DEBUG_TOP)
+            count++;
+        else if (gl_counters[i] <= gl_counters[top[GL_DEBUG_TOP - 1]])
+            continue;
+        else
+            at = GL_DEBUG_TOP - 1;
+        while (at > 0 && gl_counters[top[at - 1]] < gl_counters[i]) {
+            top[at] = top[at - 1];
+            at--;
+        }
+        top[at] = i;
+    }
+
+    log_info("gl_debug: %.1f calls/frame", (double) total / frames);
+    for (int i = 0; i < count; i++)
+        log_info("gl_debug:   %-24s %8.1f", gl_loader_names[top[i]], (double) gl_counters[top[i]] / frames);
+    for (unsigned int i = 0; i < GL_DEBUG_MAX_MESSAGES && message_count; i++) {
+        if (messages[i].repeats)
+            log_info("gl_debug: repeated %lu times: %s", messages[i].repeats, messages[i].text);
+        messages[i].repeats = 0;
+    }
+
+    memset(gl_counters, 0, sizeof(gl_counters[0]) * gl_loader_count);
+    frames = 0;
+}
+
+void gl_debug_label(GLenum identifier, GLuint name, const char *fmt, ...)
+{
+    if (!has_khr_debug || !name)
+        return;
+    char label[64];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(label, sizeof(label), fmt, ap);
+    va_end(ap);
+    glObjectLabel(identifier, name, -1, label);
+}
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#include "gl_loader.h"
+
+#define GL_DEBUG_MAX_MESSAGES 256   /* distinct messages remembered for deduplication */
+#define GL_DEBUG_TOP 8              /* busiest entry points per report */
+
+/* GL call instrumentation, built with -DGL_DEBUG ('make GL_DEBUG=1') and
+ * compiled out entirely otherwise: every gl_debug_ function below becomes
+ * a no-op macro whose arguments are never evaluated.
+ *
+ * gl_debug_init() asks for a debug context's KHR_debug output and routes
+ * it to the log, each distinct message once with a repeat count in the
+ * next report; performance warnings come through at LOG_WARN. Without
+ * KHR_debug, glGetError() is polled after every call instead. It also
+ * wraps every loader entry point (gl_counters.c) to count calls, which
+ * gl_debug_report() logs per frame for the busiest ones. gl_debug_label()
+ * names objects for the debug messages and GL debuggers. Call all of it on
+ * the thread owning the context, right after gl_loader_init(). */
+#ifdef GL_DEBUG
+#define GL_COUNTERS
+#endif
+
+/* The call counters on their own are built with -DGL_COUNTERS, which
+ * renderbench sets to measure calls per frame, and are not in a release
+ * camera. gl_counters[] is indexed like gl_loader_names; hooking twice is
+ * a no-op. */
+extern unsigned long gl_counters[];
+void gl_counters_hook(void);
+
+#ifdef GL_DEBUG
+void gl_debug_init(void);
+void gl_debug_frame(void);
+void gl_debug_report(void);
+void gl_debug_label(GLenum identifier, GLuint name, const char *fmt, ...);
+
+/* Used by the generated counters. */
+extern bool gl_debug_poll_errors;
+void gl_debug_error(unsigned int id, GLenum error);
+#else
+#define gl_debug_init() ((void) 0)
+#define gl_debug_frame() ((void) 0)
+#define gl_debug_report() ((void) 0)
+#define gl_debug_label(...) ((void) 0)
+#define gl_debug_poll_errors false
+#define gl_debug_error(id, error) ((void) 0)
+#endif
@@ -0,0 +1,728 @@
+/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */
+#include "gl_loader.h"
+#include "log.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static GLLoaderGetProc get_proc;
+static unsigned int resolved;
+static uint64_t extensions;
+static bool extensions_known;
+
+const char *const gl_loader_names[] = {
+    "glAttachShader",
+    "glBindBuffer",
+    "glBindBufferRange",
+    "glBindFramebuffer",
+    "glBindRenderbuffer",
+    "glBindVertexArray",
+    "glBufferData",
+    "glBufferStorage",
+    "glBufferSubData",
+    "glCheckFramebufferStatus",
+    "glClear",
+    "glClearColor",
+    "glClientWaitSync",
+    "glCompileShader",
+    "glCopyBufferSubData",
+    "glCreateProgram",
+    "glCreateShader",
+    "glDebugMessageCallback",
+    "glDebugMessageControl",
+    "glDeleteBuffers",
+    "glDeleteFramebuffers",
+    "glDeleteProgram",
+    "glDeleteQueries",
+    "glDeleteRenderbuffers",
+    "glDeleteShader",
+    "glDeleteSync",
+    "glDeleteVertexArrays",
+    "glDetachShader",
+    "glDrawElements",
+    "glEnable",
+    "glEnableVertexAttribArray",
+    "glFenceSync",
+    "glFinish",
+    "glFlushMappedBufferRange",
+    "glFramebufferRenderbuffer",
+    "glGenBuffers",
+    "glGenFramebuffers",
+    "glGenQueries",
+    "glGenRenderbuffers",
+    "glGenVertexArrays",
+    "glGetError",
+    "glGetInteger64v",
+    "glGetIntegerv",
+    "glGetProgramInfoLog",
+    "glGetProgramiv",
+    "glGetQueryObjectiv",
+    "glGetQueryObjectui64v",
+    "glGetShaderInfoLog",
+    "glGetShaderiv",
+    "glGetString",
+    "glGetStringi",
+    "glGetUniformBlockIndex",
+    "glGetUniformLocation",
+    "glLinkProgram",
+    "glMapBufferRange",
+    "glObjectLabel",
+    "glQueryCounter",
+    "glRenderbufferStorage",
+    "glShaderSource",
+    "glUniformBlockBinding",
+    "glUniformMatrix4fv",
+    "glUnmapBuffer",
+    "glUseProgram",
+    "glVertexAttribDivisor",
+    "glVertexAttribPointer",
+    "glViewport",
+};
+const unsigned int gl_loader_count = 66;
+
+static const char *const extension_names[] = {
+    "GL_ARB_buffer_storage",
+    "GL_ARB_timer_query",
+    "GL_KHR_debug",
+    NULL
+};
+
+void gl_loader_init(GLLoaderGetProc proc)
+{
+    get_proc = proc;
+    extensions_known = false;
+}
+
+unsigned int gl_loader_resolved(void)
+{
+    return resolved;
+}
+
+/* Queried once per context, the first time any extension is asked about. */
+bool gl_loader_has(GLLoaderExtension ext)
+{
+    if (!extensions_known) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        extensions = 0;
+        for (GLint i = 0; i < count; i++) {
+            const char *name = (const char *) glGetStringi(GL_EXTENSIONS, i);
+            for (int e = 0; e < GL_LOADER_EXT_COUNT; e++)
+                if (!strcmp(name, extension_names[e]))
+                    extensions |= UINT64_C(1) << e;
+        }
+        extensions_known = true;
+    }
+    return extensions >> ext & 1;
+}
+
+/* GL calls stay on the context's thread, so the patch needs no atomics. */
+static GLLoaderProc resolve(const char *name)
+{
+    GLLoaderProc proc = get_proc ? get_proc(name) : NULL;
+    if (!proc) {
+        log_fatal("gl_loader: cannot resolve %s", name);
+        exit(1);
+    }
+    resolved++;
+    return proc;
+}
+
+static void APIENTRY trampoline_glAttachShader(GLuint program, GLuint shader)
+{
+    gl_loader_glAttachShader = (PFNGLATTACHSHADERPROC) resolve("glAttachShader");
+    gl_loader_glAttachShader(program, shader);
+}
+PFNGLATTACHSHADERPROC gl_loader_glAttachShader = trampoline_glAttachShader;
+
+static void APIENTRY trampoline_glBindBuffer(GLenum target, GLuint buffer)
+{
+    gl_loader_glBindBuffer = (PFNGLBINDBUFFERPROC) resolve("glBindBuffer");
+    gl_loader_glBindBuffer(target, buffer);
+}
+PFNGLBINDBUFFERPROC gl_loader_glBindBuffer = trampoline_glBindBuffer;
+
+static void APIENTRY trampoline_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    gl_loader_glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC) resolve("glBindBufferRange");
+    gl_loader_glBindBufferRange(target, index, buffer, offset, size);
+}
+PFNGLBINDBUFFERRANGEPROC gl_loader_glBindBufferRange = trampoline_glBindBufferRange;
+
+static void APIENTRY trampoline_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    gl_loader_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC) resolve("glBindFramebuffer");
+    gl_loader_glBindFramebuffer(target, framebuffer);
+}
+PFNGLBINDFRAMEBUFFERPROC gl_loader_glBindFramebuffer = trampoline_glBindFramebuffer;
+
+static void APIENTRY trampoline_glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    gl_loader_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC) resolve("glBindRenderbuffer");
+    gl_loader_glBindRenderbuffer(target, renderbuffer);
+}
+PFNGLBINDRENDERBUFFERPROC gl_loader_glBindRenderbuffer = trampoline_glBindRenderbuffer;
+
+static void APIENTRY trampoline_glBindVertexArray(GLuint array)
+{
+    gl_loader_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC) resolve("glBindVertexArray");
+    gl_loader_glBindVertexArray(array);
+}
+PFNGLBINDVERTEXARRAYPROC gl_loader_glBindVertexArray = trampoline_glBindVertexArray;
+
+static void APIENTRY trampoline_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    gl_loader_glBufferData = (PFNGLBUFFERDATAPROC) resolve("glBufferData");
+    gl_loader_glBufferData(target, size, data, usage);
+}
+PFNGLBUFFERDATAPROC gl_loader_glBufferData = trampoline_glBufferData;
+
+static void APIENTRY trampoline_glBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    gl_loader_glBufferStorage = (PFNGLBUFFERSTORAGEPROC) resolve("glBufferStorage");
+    gl_loader_glBufferStorage(target, size, data, flags);
+}
+PFNGLBUFFERSTORAGEPROC gl_loader_glBufferStorage = trampoline_glBufferStorage;
+
+static void APIENTRY trampoline_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    gl_loader_glBufferSubData = (PFNGLBUFFERSUBDATAPROC) resolve("glBufferSubData");
+    gl_loader_glBufferSubData(target, offset, size, data);
+}
+PFNGLBUFFERSUBDATAPROC gl_loader_glBufferSubData = trampoline_glBufferSubData;
+
+static GLenum APIENTRY trampoline_glCheckFramebufferStatus(GLenum target)
+{
+    gl_loader_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC) resolve("glCheckFramebufferStatus");
+    return gl_loader_glCheckFramebufferStatus(target);
+}
+PFNGLCHECKFRAMEBUFFERSTATUSPROC gl_loader_glCheckFramebufferStatus = trampoline_glCheckFramebufferStatus;
+
+static void APIENTRY trampoline_glClear(GLbitfield mask)
+{
+    gl_loader_glClear = (PFNGLCLEARPROC) resolve("glClear");
+    gl_loader_glClear(mask);
+}
+PFNGLCLEARPROC gl_loader_glClear = trampoline_glClear;
+
+static void APIENTRY trampoline_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    gl_loader_glClearColor = (PFNGLCLEARCOLORPROC) resolve("glClearColor");
+    gl_loader_glClearColor(red, green, blue, alpha);
+}
+PFNGLCLEARCOLORPROC gl_loader_glClearColor = trampoline_glClearColor;
+
+static GLenum APIENTRY trampoline_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    gl_loader_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC) resolve("glClientWaitSync");
+    return gl_loader_glClientWaitSync(sync, flags, timeout);
+}
+PFNGLCLIENTWAITSYNCPROC gl_loader_glClientWaitSync = trampoline_glClientWaitSync;
+
+static void APIENTRY trampoline_glCompileShader(GLuint shader)
+{
+    gl_loader_glCompileShader = (PFNGLCOMPILESHADERPROC) resolve("glCompileShader");
+    gl_loader_glCompileShader(shader);
+}
+PFNGLCOMPILESHADERPROC gl_loader_glCompileShader = trampoline_glCompileShader;
+
+static void APIENTRY trampoline_glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    gl_loader_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC) resolve("glCopyBufferSubData");
+    gl_loader_glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+}
+PFNGLCOPYBUFFERSUBDATAPROC gl_loader_glCopyBufferSubData = trampoline_glCopyBufferSubData;
+
+static GLuint APIENTRY trampoline_glCreateProgram(void)
+{
+    gl_loader_glCreateProgram = (PFNGLCREATEPROGRAMPROC) resolve("glCreateProgram");
+    return gl_loader_glCreateProgram();
+}
+PFNGLCREATEPROGRAMPROC gl_loader_glCreateProgram = trampoline_glCreateProgram;
+
+static GLuint APIENTRY trampoline_glCreateShader(GLenum type)
+{
+    gl_loader_glCreateShader = (PFNGLCREATESHADERPROC) resolve("glCreateShader");
+    return gl_loader_glCreateShader(type);
+}
+PFNGLCREATESHADERPROC gl_loader_glCreateShader = trampoline_glCreateShader;
+
+static void APIENTRY trampoline_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam)
+{
+    gl_loader_glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC) resolve("glDebugMessageCallback");
+    gl_loader_glDebugMessageCallback(callback, userParam);
+}
+PFNGLDEBUGMESSAGECALLBACKPROC gl_loader_glDebugMessageCallback = trampoline_glDebugMessageCallback;
+
+static void APIENTRY trampoline_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled)
+{
+    gl_loader_glDebugMessageControl = (PFNGLDEBUGMESSAGECONTROLPROC) resolve("glDebugMessageControl");
+    gl_loader_glDebugMessageControl(source, type, severity, count, ids, enabled);
+}
+PFNGLDEBUGMESSAGECONTROLPROC gl_loader_glDebugMessageControl = trampoline_glDebugMessageControl;
+
+static void APIENTRY trampoline_glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    gl_loader_glDeleteBuffers = (PFNGLDELETEBUFFERSPROC) resolve("glDeleteBuffers");
+    gl_loader_glDeleteBuffers(n, buffers);
+}
+PFNGLDELETEBUFFERSPROC gl_loader_glDeleteBuffers = trampoline_glDeleteBuffers;
+
+static void APIENTRY trampoline_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    gl_loader_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC) resolve("glDeleteFramebuffers");
+    gl_loader_glDeleteFramebuffers(n, framebuffers);
+}
+PFNGLDELETEFRAMEBUFFERSPROC gl_loader_glDeleteFramebuffers = trampoline_glDeleteFramebuffers;
+
+static void APIENTRY trampoline_glDeleteProgram(GLuint program)
+{
+    gl_loader_glDeleteProgram = (PFNGLDELETEPROGRAMPROC) resolve("glDeleteProgram");
+    gl_loader_glDeleteProgram(program);
+}
+PFNGLDELETEPROGRAMPROC gl_loader_glDeleteProgram = trampoline_glDeleteProgram;
+
+static void APIENTRY trampoline_glDeleteQueries(GLsizei n, const GLuint *ids)
+{
+    gl_loader_glDeleteQueries = (PFNGLDELETEQUERIESPROC) resolve("glDeleteQueries");
+    gl_loader_glDeleteQueries(n, ids);
+}
+PFNGLDELETEQUERIESPROC gl_loader_glDeleteQueries = trampoline_glDeleteQueries;
+
+static void APIENTRY trampoline_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+    gl_loader_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC) resolve("glDeleteRenderbuffers");
+    gl_loader_glDeleteRenderbuffers(n, renderbuffers);
+}
+PFNGLDELETERENDERBUFFERSPROC gl_loader_glDeleteRenderbuffers = trampoline_glDeleteRenderbuffers;
+
+static void APIENTRY trampoline_glDeleteShader(GLuint shader)
+{
+    gl_loader_glDeleteShader = (PFNGLDELETESHADERPROC) resolve("glDeleteShader");
+    gl_loader_glDeleteShader(shader);
+}
+PFNGLDELETESHADERPROC gl_loader_glDeleteShader = trampoline_glDeleteShader;
+
+static void APIENTRY trampoline_glDeleteSync(GLsync sync)
+{
+    gl_loader_glDeleteSync = (PFNGLDELETESYNCPROC) resolve("glDeleteSync");
+    gl_loader_glDeleteSync(sync);
+}
+PFNGLDELETESYNCPROC gl_loader_glDeleteSync = trampoline_glDeleteSync;
+
+static void APIENTRY trampoline_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    gl_loader_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC) resolve("glDeleteVertexArrays");
+    gl_loader_glDeleteVertexArrays(n, arrays);
+}
+PFNGLDELETEVERTEXARRAYSPROC gl_loader_glDeleteVertexArrays = trampoline_glDeleteVertexArrays;
+
+static void APIENTRY trampoline_glDetachShader(GLuint program, GLuint shader)
+{
+    gl_loader_glDetachShader = (PFNGLDETACHSHADERPROC) resolve("glDetachShader");
+    gl_loader_glDetachShader(program, shader);
+}
+PFNGLDETACHSHADERPROC gl_loader_glDetachShader = trampoline_glDetachShader;
+
+static void APIENTRY trampoline_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    gl_loader_glDrawElements = (PFNGLDRAWELEMENTSPROC) resolve("glDrawElements");
+    gl_loader_glDrawElements(mode, count, type, indices);
+}
+PFNGLDRAWELEMENTSPROC gl_loader_glDrawElements = trampoline_glDrawElements;
+
+static void APIENTRY trampoline_glEnable(GLenum cap)
+{
+    gl_loader_glEnable = (PFNGLENABLEPROC) resolve("glEnable");
+    gl_loader_glEnable(cap);
+}
+PFNGLENABLEPROC gl_loader_glEnable = trampoline_glEnable;
+
+static void APIENTRY trampoline_glEnableVertexAttribArray(GLuint index)
+{
+    gl_loader_glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC) resolve("glEnableVertexAttribArray");
+    gl_loader_glEnableVertexAttribArray(index);
+}
+PFNGLENABLEVERTEXATTRIBARRAYPROC gl_loader_glEnableVertexAttribArray = trampoline_glEnableVertexAttribArray;
+
+static GLsync APIENTRY trampoline_glFenceSync(GLenum condition, GLbitfield flags)
+{
+    gl_loader_glFenceSync = (PFNGLFENCESYNCPROC) resolve("glFenceSync");
+    return gl_loader_glFenceSync(condition, flags);
+}
+PFNGLFENCESYNCPROC gl_loader_glFenceSync = trampoline_glFenceSync;
+
+static void APIENTRY trampoline_glFinish(void)
+{
+    gl_loader_glFinish = (PFNGLFINISHPROC) resolve("glFinish");
+    gl_loader_glFinish();
+}
+PFNGLFINISHPROC gl_loader_glFinish = trampoline_glFinish;
+
+static void APIENTRY trampoline_glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    gl_loader_glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC) resolve("glFlushMappedBufferRange");
+    gl_loader_glFlushMappedBufferRange(target, offset, length);
+}
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC gl_loader_glFlushMappedBufferRange = trampoline_glFlushMappedBufferRange;
+
+static void APIENTRY trampoline_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    gl_loader_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC) resolve("glFramebufferRenderbuffer");
+    gl_loader_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+PFNGLFRAMEBUFFERRENDERBUFFERPROC gl_loader_glFramebufferRenderbuffer = trampoline_glFramebufferRenderbuffer;
+
+static void APIENTRY trampoline_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+    gl_loader_glGenBuffers = (PFNGLGENBUFFERSPROC) resolve("glGenBuffers");
+    gl_loader_glGenBuffers(n, buffers);
+}
+PFNGLGENBUFFERSPROC gl_loader_glGenBuffers = trampoline_glGenBuffers;
+
+static void APIENTRY trampoline_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+    gl_loader_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC) resolve("glGenFramebuffers");
+    gl_loader_glGenFramebuffers(n, framebuffers);
+}
+PFNGLGENFRAMEBUFFERSPROC gl_loader_glGenFramebuffers = trampoline_glGenFramebuffers;
+
+static void APIENTRY trampoline_glGenQueries(GLsizei n, GLuint *ids)
+{
+    gl_loader_glGenQueries = (PFNGLGENQUERIESPROC) resolve("glGenQueries");
+    gl_loader_glGenQueries(n, ids);
+}
+PFNGLGENQUERIESPROC gl_loader_glGenQueries = trampoline_glGenQueries;
+
+static void APIENTRY trampoline_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+    gl_loader_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC) resolve("glGenRenderbuffers");
+    gl_loader_glGenRenderbuffers(n, renderbuffers);
+}
+PFNGLGENRENDERBUFFERSPROC gl_loader_glGenRenderbuffers = trampoline_glGenRenderbuffers;
+
+static void APIENTRY trampoline_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+    gl_loader_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC) resolve("glGenVertexArrays");
+    gl_loader_glGenVertexArrays(n, arrays);
+}
+PFNGLGENVERTEXARRAYSPROC gl_loader_glGenVertexArrays = trampoline_glGenVertexArrays;
+
+static GLenum APIENTRY trampoline_glGetError(void)
+{
+    gl_loader_glGetError = (PFNGLGETERRORPROC) resolve("glGetError");
+    return gl_loader_glGetError();
+}
+PFNGLGETERRORPROC gl_loader_glGetError = trampoline_glGetError;
+
+static void APIENTRY trampoline_glGetInteger64v(GLenum pname, GLint64 *data)
+{
+    gl_loader_glGetInteger64v = (PFNGLGETINTEGER64VPROC) resolve("glGetInteger64v");
+    gl_loader_glGetInteger64v(pname, data);
+}
+PFNGLGETINTEGER64VPROC gl_loader_glGetInteger64v = trampoline_glGetInteger64v;
+
+static void APIENTRY trampoline_glGetIntegerv(GLenum pname, GLint *data)
+{
+    gl_loader_glGetIntegerv = (PFNGLGETINTEGERVPROC) resolve("glGetIntegerv");
+    gl_loader_glGetIntegerv(pname, data);
+}
+PFNGLGETINTEGERVPROC gl_loader_glGetIntegerv = trampoline_glGetIntegerv;
+
+static void APIENTRY trampoline_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    gl_loader_glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC) resolve("glGetProgramInfoLog");
+    gl_loader_glGetProgramInfoLog(program, bufSize, length, infoLog);
+}
+PFNGLGETPROGRAMINFOLOGPROC gl_loader_glGetProgramInfoLog = trampoline_glGetProgramInfoLog;
+
+static void APIENTRY trampoline_glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+    gl_loader_glGetProgramiv = (PFNGLGETPROGRAMIVPROC) resolve("glGetProgramiv");
+    gl_loader_glGetProgramiv(program, pname, params);
+}
+PFNGLGETPROGRAMIVPROC gl_loader_glGetProgramiv = trampoline_glGetProgramiv;
+
+static void APIENTRY trampoline_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params)
+{
+    gl_loader_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC) resolve("glGetQueryObjectiv");
+    gl_loader_glGetQueryObjectiv(id, pname, params);
+}
+PFNGLGETQUERYOBJECTIVPROC gl_loader_glGetQueryObjectiv = trampoline_glGetQueryObjectiv;
+
+static void APIENTRY trampoline_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+    gl_loader_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC) resolve("glGetQueryObjectui64v");
+    gl_loader_glGetQueryObjectui64v(id, pname, params);
+}
+PFNGLGETQUERYOBJECTUI64VPROC gl_loader_glGetQueryObjectui64v = trampoline_glGetQueryObjectui64v;
+
+static void APIENTRY trampoline_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    gl_loader_glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC) resolve("glGetShaderInfoLog");
+    gl_loader_glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+PFNGLGETSHADERINFOLOGPROC gl_loader_glGetShaderInfoLog = trampoline_glGetShaderInfoLog;
+
+static void APIENTRY trampoline_glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+    gl_loader_glGetShaderiv = (PFNGLGETSHADERIVPROC) resolve("glGetShaderiv");
+    gl_loader_glGetShaderiv(shader, pname, params);
+}
+PFNGLGETSHADERIVPROC gl_loader_glGetShaderiv = trampoline_glGetShaderiv;
+
+static const GLubyte * APIENTRY trampoline_glGetString(GLenum name)
+{
+    gl_loader_glGetString = (PFNGLGETSTRINGPROC) resolve("glGetString");
+    return gl_loader_glGetString(name);
+}
+PFNGLGETSTRINGPROC gl_loader_glGetString = trampoline_glGetString;
+
+static const GLubyte * APIENTRY trampoline_glGetStringi(GLenum name, GLuint index)
+{
+    gl_loader_glGetStringi = (PFNGLGETSTRINGIPROC) resolve("glGetStringi");
+    return gl_loader_glGetStringi(name, index);
+}
+PFNGLGETSTRINGIPROC gl_loader_glGetStringi = trampoline_glGetStringi;
+
+static GLuint APIENTRY trampoline_glGetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+    gl_loader_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC) resolve("glGetUniformBlockIndex");
+    return gl_loader_glGetUniformBlockIndex(program, uniformBlockName);
+}
+PFNGLGETUNIFORMBLOCKINDEXPROC gl_loader_glGetUniformBlockIndex = trampoline_glGetUniformBlockIndex;
+
+static GLint APIENTRY trampoline_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+    gl_loader_glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC) resolve("glGetUniformLocation");
+    return gl_loader_glGetUniformLocation(program, name);
+}
+PFNGLGETUNIFORMLOCATIONPROC gl_loader_glGetUniformLocation = trampoline_glGetUniformLocation;
+
+static void APIENTRY trampoline_glLinkProgram(GLuint program)
+{
+    gl_loader_glLinkProgram = (PFNGLLINKPROGRAMPROC) resolve("glLinkProgram");
+    gl_loader_glLinkProgram(program);
+}
+PFNGLLINKPROGRAMPROC gl_loader_glLinkProgram = trampoline_glLinkProgram;
+
+static void * APIENTRY trampoline_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    gl_loader_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC) resolve("glMapBufferRange");
+    return gl_loader_glMapBufferRange(target, offset, length, access);
+}
+PFNGLMAPBUFFERRANGEPROC gl_loader_glMapBufferRange = trampoline_glMapBufferRange;
+
+static void APIENTRY trampoline_glObjectLabel(GLenum identifier, GLuint name, GLsizei length, const GLchar *label)
+{
+    gl_loader_glObjectLabel = (PFNGLOBJECTLABELPROC) resolve("glObjectLabel");
+    gl_loader_glObjectLabel(identifier, name, length, label);
+}
+PFNGLOBJECTLABELPROC gl_loader_glObjectLabel = trampoline_glObjectLabel;
+
+static void APIENTRY trampoline_glQueryCounter(GLuint id, GLenum target)
+{
+    gl_loader_glQueryCounter = (PFNGLQUERYCOUNTERPROC) resolve("glQueryCounter");
+    gl_loader_glQueryCounter(id, target);
+}
+PFNGLQUERYCOUNTERPROC gl_loader_glQueryCounter = trampoline_glQueryCounter;
+
+static void APIENTRY trampoline_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    gl_loader_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC) resolve("glRenderbufferStorage");
+    gl_loader_glRenderbufferStorage(target, internalformat, width, height);
+}
+PFNGLRENDERBUFFERSTORAGEPROC gl_loader_glRenderbufferStorage = trampoline_glRenderbufferStorage;
+
+static void APIENTRY trampoline_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)
+{
+    gl_loader_glShaderSource = (PFNGLSHADERSOURCEPROC) resolve("glShaderSource");
+    gl_loader_glShaderSource(shader, count, string, length);
+}
+PFNGLSHADERSOURCEPROC gl_loader_glShaderSource = trampoline_glShaderSource;
+
+static void APIENTRY trampoline_glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+    gl_loader_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC) resolve("glUniformBlockBinding");
+    gl_loader_glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+}
+PFNGLUNIFORMBLOCKBINDINGPROC gl_loader_glUniformBlockBinding = trampoline_glUniformBlockBinding;
+
+static void APIENTRY trampoline_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    gl_loader_glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC) resolve("glUniformMatrix4fv");
+    gl_loader_glUniformMatrix4fv(location, count, transpose, value);
+}
+PFNGLUNIFORMMATRIX4FVPROC gl_loader_glUniformMatrix4fv = trampoline_glUniformMatrix4fv;
+
+static GLboolean APIENTRY trampoline_glUnmapBuffer(GLenum target)
+{
+    gl_loader_glUnmapBuffer = (PFNGLUNMAPBUFFERPROC) resolve("glUnmapBuffer");
+    return gl_loader_glUnmapBuffer(target);
+}
+PFNGLUNMAPBUFFERPROC gl_loader_glUnmapBuffer = trampoline_glUnmapBuffer;
+
+static void APIENTRY trampoline_glUseProgram(GLuint program)
+{
+    gl_loader_glUseProgram = (PFNGLUSEPROGRAMPROC) resolve("glUseProgram");
+    gl_loader_glUseProgram(program);
+}
+PFNGLUSEPROGRAMPROC gl_loader_glUseProgram = trampoline_glUseProgram;
+
+static void APIENTRY trampoline_glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    gl_loader_glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC) resolve("glVertexAttribDivisor");
+    gl_loader_glVertexAttribDivisor(index, divisor);
+}
+PFNGLVERTEXATTRIBDIVISORPROC gl_loader_glVertexAttribDivisor = trampoline_glVertexAttribDivisor;
+
+static void APIENTRY trampoline_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+    gl_loader_glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC) resolve("glVertexAttribPointer");
+    gl_loader_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+PFNGLVERTEXATTRIBPOINTERPROC gl_loader_glVertexAttribPointer = trampoline_glVertexAttribPointer;
+
+static void APIENTRY trampoline_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    gl_loader_glViewport = (PFNGLVIEWPORTPROC) resolve("glViewport");
+    gl_loader_glViewport(x, y, width, height);
+}
+PFNGLVIEWPORTPROC gl_loader_glViewport = trampoline_glViewport;
+
+void gl_loader_resolve_all(void)
+{
+    GLLoaderProc proc;
+    if (gl_loader_glAttachShader == trampoline_glAttachShader && get_proc && (proc = get_proc("glAttachShader")))
+        gl_loader_glAttachShader = (PFNGLATTACHSHADERPROC) proc;
+    if (gl_loader_glBindBuffer == trampoline_glBindBuffer && get_proc && (proc = get_proc("glBindBuffer")))
+        gl_loader_glBindBuffer = (PFNGLBINDBUFFERPROC) proc;
+    if (gl_loader_glBindBufferRange == trampoline_glBindBufferRange && get_proc && (proc = get_proc("glBindBufferRange")))
+        gl_loader_glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC) proc;
+    if (gl_loader_glBindFramebuffer == trampoline_glBindFramebuffer && get_proc && (proc = get_proc("glBindFramebuffer")))
+        gl_loader_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC) proc;
+    if (gl_loader_glBindRenderbuffer == trampoline_glBindRenderbuffer && get_proc && (proc = get_proc("glBindRenderbuffer")))
+        gl_loader_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC) proc;
+    if (gl_loader_glBindVertexArray == trampoline_glBindVertexArray && get_proc && (proc = get_proc("glBindVertexArray")))
+        gl_loader_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC) proc;
+    if (gl_loader_glBufferData == trampoline_glBufferData && get_proc && (proc = get_proc("glBufferData")))
+        gl_loader_glBufferData = (PFNGLBUFFERDATAPROC) proc;
+    if (gl_loader_glBufferStorage == trampoline_glBufferStorage && get_proc && (proc = get_proc("glBufferStorage")))
+        gl_loader_glBufferStorage = (PFNGLBUFFERSTORAGEPROC) proc;
+    if (gl_loader_glBufferSubData == trampoline_glBufferSubData && get_proc && (proc = get_proc("glBufferSubData")))
+        gl_loader_glBufferSubData = (PFNGLBUFFERSUBDATAPROC) proc;
+    if (gl_loader_glCheckFramebufferStatus == trampoline_glCheckFramebufferStatus && get_proc && (proc = get_proc("glCheckFramebufferStatus")))
+        gl_loader_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC) proc;
+    if (gl_loader_glClear == trampoline_glClear && get_proc && (proc = get_proc("glClear")))
+        gl_loader_glClear = (PFNGLCLEARPROC) proc;
+    if (gl_loader_glClearColor == trampoline_glClearColor && get_proc && (proc = get_proc("glClearColor")))
+        gl_loader_glClearColor = (PFNGLCLEARCOLORPROC) proc;
+    if (gl_loader_glClientWaitSync == trampoline_glClientWaitSync && get_proc && (proc = get_proc("glClientWaitSync")))
+        gl_loader_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC) proc;
+    if (gl_loader_glCompileShader == trampoline_glCompileShader && get_proc && (proc = get_proc("glCompileShader")))
+        gl_loader_glCompileShader = (PFNGLCOMPILESHADERPROC) proc;
+    if (gl_loader_glCopyBufferSubData == trampoline_glCopyBufferSubData && get_proc && (proc = get_proc("glCopyBufferSubData")))
+        gl_loader_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC) proc;
+    if (gl_loader_glCreateProgram == trampoline_glCreateProgram && get_proc && (proc = get_proc("glCreateProgram")))
+        gl_loader_glCreateProgram = (PFNGLCREATEPROGRAMPROC) proc;
+    if (gl_loader_glCreateShader == trampoline_glCreateShader && get_proc && (proc = get_proc("glCreateShader")))
+        gl_loader_glCreateShader = (PFNGLCREATESHADERPROC) proc;
+    if (gl_loader_glDebugMessageCallback == trampoline_glDebugMessageCallback && get_proc && (proc = get_proc("glDebugMessageCallback")))
+        gl_loader_glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC) proc;
+    if (gl_loader_glDebugMessageControl == trampoline_glDebugMessageControl && get_proc && (proc = get_proc("glDebugMessageControl")))
+        gl_loader_glDebugMessageControl = (PFNGLDEBUGMESSAGECONTROLPROC) proc;
+    if (gl_loader_glDeleteBuffers == trampoline_glDeleteBuffers && get_proc && (proc = get_proc("glDeleteBuffers")))
+        gl_loader_glDeleteBuffers = (PFNGLDELETEBUFFERSPROC) proc;
+    if (gl_loader_glDeleteFramebuffers == trampoline_glDeleteFramebuffers && get_proc && (proc = get_proc("glDeleteFramebuffers")))
+        gl_loader_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC) proc;
+    if (gl_loader_glDeleteProgram == trampoline_glDeleteProgram && get_proc && (proc = get_proc("glDeleteProgram")))
+        gl_loader_glDeleteProgram = (PFNGLDELETEPROGRAMPROC) proc;
+    if (gl_loader_glDeleteQueries == trampoline_glDeleteQueries && get_proc && (proc = get_proc("glDeleteQueries")))
+        gl_loader_glDeleteQueries = (PFNGLDELETEQUERIESPROC) proc;
+    if (gl_loader_glDeleteRenderbuffers == trampoline_glDeleteRenderbuffers && get_proc && (proc = get_proc("glDeleteRenderbuffers")))
+        gl_loader_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC) proc;
+    if (gl_loader_glDeleteShader == trampoline_glDeleteShader && get_proc && (proc = get_proc("glDeleteShader")))
+        gl_loader_glDeleteShader = (PFNGLDELETESHADERPROC) proc;
+    if (gl_loader_glDeleteSync == trampoline_glDeleteSync && get_proc && (proc = get_proc("glDeleteSync")))
+        gl_loader_glDeleteSync = (PFNGLDELETESYNCPROC) proc;
+    if (gl_loader_glDeleteVertexArrays == trampoline_glDeleteVertexArrays && get_proc && (proc = get_proc("glDeleteVertexArrays")))
+        gl_loader_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC) proc;
+    if (gl_loader_glDetachShader == trampoline_glDetachShader && get_proc && (proc = get_proc("glDetachShader")))
+        gl_loader_glDetachShader = (PFNGLDETACHSHADERPROC) proc;
+    if (gl_loader_glDrawElements == trampoline_glDrawElements && get_proc && (proc = get_proc("glDrawElements")))
+        gl_loader_glDrawElements = (PFNGLDRAWELEMENTSPROC) proc;
+    if (gl_loader_glEnable == trampoline_glEnable && get_proc && (proc = get_proc("glEnable")))
+        gl_loader_glEnable = (PFNGLENABLEPROC) proc;
+    if (gl_loader_glEnableVertexAttribArray == trampoline_glEnableVertexAttribArray && get_proc && (proc = get_proc("glEnableVertexAttribArray")))
+        gl_loader_glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC) proc;
+    if (gl_loader_glFenceSync == trampoline_glFenceSync && get_proc && (proc = get_proc("glFenceSync")))
+        gl_loader_glFenceSync = (PFNGLFENCESYNCPROC) proc;
+    if (gl_loader_glFinish == trampoline_glFinish && get_proc && (proc = get_proc("glFinish")))
+        gl_loader_glFinish = (PFNGLFINISHPROC) proc;
+    if (gl_loader_glFlushMappedBufferRange == trampoline_glFlushMappedBufferRange && get_proc && (proc = get_proc("glFlushMappedBufferRange")))
+        gl_loader_glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC) proc;
+    if (gl_loader_glFramebufferRenderbuffer == trampoline_glFramebufferRenderbuffer && get_proc && (proc = get_proc("glFramebufferRenderbuffer")))
+        gl_loader_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC) proc;
+    if (gl_loader_glGenBuffers == trampoline_glGenBuffers && get_proc && (proc = get_proc("glGenBuffers")))
+        gl_loader_glGenBuffers = (PFNGLGENBUFFERSPROC) proc;
+    if (gl_loader_glGenFramebuffers == trampoline_glGenFramebuffers && get_proc && (proc = get_proc("glGenFramebuffers")))
+        gl_loader_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC) proc;
+    if (gl_loader_glGenQueries == trampoline_glGenQueries && get_proc && (proc = get_proc("glGenQueries")))
+        gl_loader_glGenQueries = (PFNGLGENQUERIESPROC) proc;
+    if (gl_loader_glGenRenderbuffers == trampoline_glGenRenderbuffers && get_proc && (proc = get_proc("glGenRenderbuffers")))
+        gl_loader_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC) proc;
+    if (gl_loader_glGenVertexArrays == trampoline_glGenVertexArrays && get_proc && (proc = get_proc("glGenVertexArrays")))
+        gl_loader_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC) proc;
+    if (gl_loader_glGetError == trampoline_glGetError && get_proc && (proc = get_proc("glGetError")))
+        gl_loader_glGetError = (PFNGLGETERRORPROC) proc;
+    if (gl_loader_glGetInteger64v == trampoline_glGetInteger64v && get_proc && (proc = get_proc("glGetInteger64v")))
+        gl_loader_glGetInteger64v = (PFNGLGETINTEGER64VPROC) proc;
+    if (gl_loader_glGetIntegerv == trampoline_glGetIntegerv && get_proc && (proc = get_proc("glGetIntegerv")))
+        gl_loader_glGetIntegerv = (PFNGLGETINTEGERVPROC) proc;
+    if (gl_loader_glGetProgramInfoLog == trampoline_glGetProgramInfoLog && get_proc && (proc = get_proc("glGetProgramInfoLog")))
+        gl_loader_glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC) proc;
+    if (gl_loader_glGetProgramiv == trampoline_glGetProgramiv && get_proc && (proc = get_proc("glGetProgramiv")))
+        gl_loader_glGetProgramiv = (PFNGLGETPROGRAMIVPROC) proc;
+    if (gl_loader_glGetQueryObjectiv == trampoline_glGetQueryObjectiv && get_proc && (proc = get_proc("glGetQueryObjectiv")))
+        gl_loader_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC) proc;
+    if (gl_loader_glGetQueryObjectui64v == trampoline_glGetQueryObjectui64v && get_proc && (proc = get_proc("glGetQueryObjectui64v")))
+        gl_loader_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC) proc;
+    if (gl_loader_glGetShaderInfoLog == trampoline_glGetShaderInfoLog && get_proc && (proc = get_proc("glGetShaderInfoLog")))
+        gl_loader_glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC) proc;
+    if (gl_loader_glGetShaderiv == trampoline_glGetShaderiv && get_proc && (proc = get_proc("glGetShaderiv")))
+        gl_loader_glGetShaderiv = (PFNGLGETSHADERIVPROC) proc;
+    if (gl_loader_glGetString == trampoline_glGetString && get_proc && (proc = get_proc("glGetString")))
+        gl_loader_glGetString = (PFNGLGETSTRINGPROC) proc;
+    if (gl_loader_glGetStringi == trampoline_glGetStringi && get_proc && (proc = get_proc("glGetStringi")))
+        gl_loader_glGetStringi = (PFNGLGETSTRINGIPROC) proc;
+    if (gl_loader_glGetUniformBlockIndex == trampoline_glGetUniformBlockIndex && get_proc && (proc = get_proc("glGetUniformBlockIndex")))
+        gl_loader_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC) proc;
+    if (gl_loader_glGetUniformLocation == trampoline_glGetUniformLocation && get_proc && (proc = get_proc("glGetUniformLocation")))
+        gl_loader_glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC) proc;
+    if (gl_loader_glLinkProgram == trampoline_glLinkProgram && get_proc && (proc = get_proc("glLinkProgram")))
+        gl_loader_glLinkProgram = (PFNGLLINKPROGRAMPROC) proc;
+    if (gl_loader_glMapBufferRange == trampoline_glMapBufferRange && get_proc && (proc = get_proc("glMapBufferRange")))
+        gl_loader_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC) proc;
+    if (gl_loader_glObjectLabel == trampoline_glObjectLabel && get_proc && (proc = get_proc("glObjectLabel")))
+        gl_loader_glObjectLabel = (PFNGLOBJECTLABELPROC) proc;
+    if (gl_loader_glQueryCounter == trampoline_glQueryCounter && get_proc && (proc = get_proc("glQueryCounter")))
+        gl_loader_glQueryCounter = (PFNGLQUERYCOUNTERPROC) proc;
+    if (gl_loader_glRenderbufferStorage == trampoline_glRenderbufferStorage && get_proc && (proc = get_proc("glRenderbufferStorage")))
+        gl_loader_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC) proc;
+    if (gl_loader_glShaderSource == trampoline_glShaderSource && get_proc && (proc = get_proc("glShaderSource")))
+        gl_loader_glShaderSource = (PFNGLSHADERSOURCEPROC) proc;
+    if (gl_loader_glUniformBlockBinding == trampoline_glUniformBlockBinding && get_proc && (proc = get_proc("glUniformBlockBinding")))
+        gl_loader_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC) proc;
+    if (gl_loader_glUniformMatrix4fv == trampoline_glUniformMatrix4fv && get_proc && (proc = get_proc("glUniformMatrix4fv")))
+        gl_loader_glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC) proc;
+    if (gl_loader_glUnmapBuffer == trampoline_glUnmapBuffer && get_proc && (proc = get_proc("glUnmapBuffer")))
+        gl_loader_glUnmapBuffer = (PFNGLUNMAPBUFFERPROC) proc;
+    if (gl_loader_glUseProgram == trampoline_glUseProgram && get_proc && (proc = get_proc("glUseProgram")))
+        gl_loader_glUseProgram = (PFNGLUSEPROGRAMPROC) proc;
+    if (gl_loader_glVertexAttribDivisor == trampoline_glVertexAttribDivisor && get_proc && (proc = get_proc("glVertexAttribDivisor")))
+        gl_loader_glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC) proc;
+    if (gl_loader_glVertexAttribPointer == trampoline_glVertexAttribPointer && get_proc && (proc = get_proc("glVertexAttribPointer")))
+        gl_loader_glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC) proc;
+    if (gl_loader_glViewport == trampoline_glViewport && get_proc && (proc = get_proc("glViewport")))
+        gl_loader_glViewport = (PFNGLVIEWPORTPROC) proc;
+}
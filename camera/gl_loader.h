@@ -0,0 +1,161 @@
+/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */
+#pragma once
+/* Stand in for gl.h so nothing else declares the GL API. */
+#define __gl_h_
+#define __GL_H__
+#include <GL/glcorearb.h>
+#include <stdbool.h>
+
+typedef void (*GLLoaderProc)(void);
+typedef GLLoaderProc (*GLLoaderGetProc)(const char *name);
+
+typedef enum {
+    GL_LOADER_ARB_buffer_storage,
+    GL_LOADER_ARB_timer_query,
+    GL_LOADER_KHR_debug,
+    GL_LOADER_EXT_COUNT
+} GLLoaderExtension;
+
+/* get_proc is glfwGetProcAddress or eglGetProcAddress; call it once a
+ * context is current, before the first GL call. */
+void gl_loader_init(GLLoaderGetProc get_proc);
+bool gl_loader_has(GLLoaderExtension ext);
+unsigned int gl_loader_resolved(void);
+/* Entry point names, indexed like the capture and counter tables. */
+extern const char *const gl_loader_names[];
+extern const unsigned int gl_loader_count;
+/* Resolves everything still pointing at a trampoline. */
+void gl_loader_resolve_all(void);
+
+extern PFNGLATTACHSHADERPROC gl_loader_glAttachShader;
+#define glAttachShader gl_loader_glAttachShader
+extern PFNGLBINDBUFFERPROC gl_loader_glBindBuffer;
+#define glBindBuffer gl_loader_glBindBuffer
+extern PFNGLBINDBUFFERRANGEPROC gl_loader_glBindBufferRange;
+#define glBindBufferRange gl_loader_glBindBufferRange
+extern PFNGLBINDFRAMEBUFFERPROC gl_loader_glBindFramebuffer;
+#define glBindFramebuffer gl_loader_glBindFramebuffer
+extern PFNGLBINDRENDERBUFFERPROC gl_loader_glBindRenderbuffer;
+#define glBindRenderbuffer gl_loader_glBindRenderbuffer
+extern PFNGLBINDVERTEXARRAYPROC gl_loader_glBindVertexArray;
+#define glBindVertexArray gl_loader_glBindVertexArray
+extern PFNGLBUFFERDATAPROC gl_loader_glBufferData;
+#define glBufferData gl_loader_glBufferData
+extern PFNGLBUFFERSTORAGEPROC gl_loader_glBufferStorage;
+#define glBufferStorage gl_loader_glBufferStorage
+extern PFNGLBUFFERSUBDATAPROC gl_loader_glBufferSubData;
+#define glBufferSubData gl_loader_glBufferSubData
+extern PFNGLCHECKFRAMEBUFFERSTATUSPROC gl_loader_glCheckFramebufferStatus;
+#define glCheckFramebufferStatus gl_loader_glCheckFramebufferStatus
+extern PFNGLCLEARPROC gl_loader_glClear;
+#define glClear gl_loader_glClear
+extern PFNGLCLEARCOLORPROC gl_loader_glClearColor;
+#define glClearColor gl_loader_glClearColor
+extern PFNGLCLIENTWAITSYNCPROC gl_loader_glClientWaitSync;
+#define glClientWaitSync gl_loader_glClientWaitSync
+extern PFNGLCOMPILESHADERPROC gl_loader_glCompileShader;
+#define glCompileShader gl_loader_glCompileShader
+extern PFNGLCOPYBUFFERSUBDATAPROC gl_loader_glCopyBufferSubData;
+#define glCopyBufferSubData gl_loader_glCopyBufferSubData
+extern PFNGLCREATEPROGRAMPROC gl_loader_glCreateProgram;
+#define glCreateProgram gl_loader_glCreateProgram
+extern PFNGLCREATESHADERPROC gl_loader_glCreateShader;
+#define glCreateShader gl_loader_glCreateShader
+extern PFNGLDEBUGMESSAGECALLBACKPROC gl_loader_glDebugMessageCallback;
+#define glDebugMessageCallback gl_loader_glDebugMessageCallback
+extern PFNGLDEBUGMESSAGECONTROLPROC gl_loader_glDebugMessageControl;
+#define glDebugMessageControl gl_loader_glDebugMessageControl
+extern PFNGLDELETEBUFFERSPROC gl_loader_glDeleteBuffers;
+#define glDeleteBuffers gl_loader_glDeleteBuffers
+extern PFNGLDELETEFRAMEBUFFERSPROC gl_loader_glDeleteFramebuffers;
+#define glDeleteFramebuffers gl_loader_glDeleteFramebuffers
+extern PFNGLDELETEPROGRAMPROC gl_loader_glDeleteProgram;
+#define glDeleteProgram gl_loader_glDeleteProgram
+extern PFNGLDELETEQUERIESPROC gl_loader_glDeleteQueries;
+#define glDeleteQueries gl_loader_glDeleteQueries
+extern PFNGLDELETERENDERBUFFERSPROC gl_loader_glDeleteRenderbuffers;
+#define glDeleteRenderbuffers gl_loader_glDeleteRenderbuffers
+extern PFNGLDELETESHADERPROC gl_loader_glDeleteShader;
+#define glDeleteShader gl_loader_glDeleteShader
+extern PFNGLDELETESYNCPROC gl_loader_glDeleteSync;
+#define glDeleteSync gl_loader_glDeleteSync
+extern PFNGLDELETEVERTEXARRAYSPROC gl_loader_glDeleteVertexArrays;
+#define glDeleteVertexArrays gl_loader_glDeleteVertexArrays
+extern PFNGLDETACHSHADERPROC gl_loader_glDetachShader;
+#define glDetachShader gl_loader_glDetachShader
+extern PFNGLDRAWELEMENTSPROC gl_loader_glDrawElements;
+#define glDrawElements gl_loader_glDrawElements
+extern PFNGLENABLEPROC gl_loader_glEnable;
+#define glEnable gl_loader_glEnable
+extern PFNGLENABLEVERTEXATTRIBARRAYPROC gl_loader_glEnableVertexAttribArray;
+#define glEnableVertexAttribArray gl_loader_glEnableVertexAttribArray
+extern PFNGLFENCESYNCPROC gl_loader_glFenceSync;
+#define glFenceSync gl_loader_glFenceSync
+extern PFNGLFINISHPROC gl_loader_glFinish;
+#define glFinish gl_loader_glFinish
+extern PFNGLFLUSHMAPPEDBUFFERRANGEPROC gl_loader_glFlushMappedBufferRange;
+#define glFlushMappedBufferRange gl_loader_glFlushMappedBufferRange
+extern PFNGLFRAMEBUFFERRENDERBUFFERPROC gl_loader_glFramebufferRenderbuffer;
+#define glFramebufferRenderbuffer gl_loader_glFramebufferRenderbuffer
+extern PFNGLGENBUFFERSPROC gl_loader_glGenBuffers;
+#define glGenBuffers gl_loader_glGenBuffers
+extern PFNGLGENFRAMEBUFFERSPROC gl_loader_glGenFramebuffers;
+#define glGenFramebuffers gl_loader_glGenFramebuffers
+extern PFNGLGENQUERIESPROC gl_loader_glGenQueries;
+#define glGenQueries gl_loader_glGenQueries
+extern PFNGLGENRENDERBUFFERSPROC gl_loader_glGenRenderbuffers;
+#define glGenRenderbuffers gl_loader_glGenRenderbuffers
+extern PFNGLGENVERTEXARRAYSPROC gl_loader_glGenVertexArrays;
+#define glGenVertexArrays gl_loader_glGenVertexArrays
+extern PFNGLGETERRORPROC gl_loader_glGetError;
+#define glGetError gl_loader_glGetError
+extern PFNGLGETINTEGER64VPROC gl_loader_glGetInteger64v;
+#define glGetInteger64v gl_loader_glGetInteger64v
+extern PFNGLGETINTEGERVPROC gl_loader_glGetIntegerv;
+#define glGetIntegerv gl_loader_glGetIntegerv
+extern PFNGLGETPROGRAMINFOLOGPROC gl_loader_glGetProgramInfoLog;
+#define glGetProgramInfoLog gl_loader_glGetProgramInfoLog
+extern PFNGLGETPROGRAMIVPROC gl_loader_glGetProgramiv;
+#define glGetProgramiv gl_loader_glGetProgramiv
+extern PFNGLGETQUERYOBJECTIVPROC gl_loader_glGetQueryObjectiv;
+#define glGetQueryObjectiv gl_loader_glGetQueryObjectiv
+extern PFNGLGETQUERYOBJECTUI64VPROC gl_loader_glGetQueryObjectui64v;
+#define glGetQueryObjectui64v gl_loader_glGetQueryObjectui64v
+extern PFNGLGETSHADERINFOLOGPROC gl_loader_glGetShaderInfoLog;
+#define glGetShaderInfoLog gl_loader_glGetShaderInfoLog
+extern PFNGLGETSHADERIVPROC gl_loader_glGetShaderiv;
+#define glGetShaderiv gl_loader_glGetShaderiv
+extern PFNGLGETSTRINGPROC gl_loader_glGetString;
+#define glGetString gl_loader_glGetString
+extern PFNGLGETSTRINGIPROC gl_loader_glGetStringi;
+#define glGetStringi gl_loader_glGetStringi
+extern PFNGLGETUNIFORMBLOCKINDEXPROC gl_loader_glGetUniformBlockIndex;
+#define glGetUniformBlockIndex gl_loader_glGetUniformBlockIndex
+extern PFNGLGETUNIFORMLOCATIONPROC gl_loader_glGetUniformLocation;
+#define glGetUniformLocation gl_loader_glGetUniformLocation
+extern PFNGLLINKPROGRAMPROC gl_loader_glLinkProgram;
+#define glLinkProgram gl_loader_glLinkProgram
+extern PFNGLMAPBUFFERRANGEPROC gl_loader_glMapBufferRange;
+#define glMapBufferRange gl_loader_glMapBufferRange
+extern PFNGLOBJECTLABELPROC gl_loader_glObjectLabel;
+#define glObjectLabel gl_loader_glObjectLabel
+extern PFNGLQUERYCOUNTERPROC gl_loader_glQueryCounter;
+#define glQueryCounter gl_loader_glQueryCounter
+extern PFNGLRENDERBUFFERSTORAGEPROC gl_loader_glRenderbufferStorage;
+#define glRenderbufferStorage gl_loader_glRenderbufferStorage
+extern PFNGLSHADERSOURCEPROC gl_loader_glShaderSource;
+#define glShaderSource gl_loader_glShaderSource
+extern PFNGLUNIFORMBLOCKBINDINGPROC gl_loader_glUniformBlockBinding;
+#define glUniformBlockBinding gl_loader_glUniformBlockBinding
+extern PFNGLUNIFORMMATRIX4FVPROC gl_loader_glUniformMatrix4fv;
+#define glUniformMatrix4fv gl_loader_glUniformMatrix4fv
+extern PFNGLUNMAPBUFFERPROC gl_loader_glUnmapBuffer;
+#define glUnmapBuffer gl_loader_glUnmapBuffer
+extern PFNGLUSEPROGRAMPROC gl_loader_glUseProgram;
+#define glUseProgram gl_loader_glUseProgram
+extern PFNGLVERTEXATTRIBDIVISORPROC gl_loader_glVertexAttribDivisor;
+#define glVertexAttribDivisor gl_loader_glVertexAttribDivisor
+extern PFNGLVERTEXATTRIBPOINTERPROC gl_loader_glVertexAttribPointer;
+#define glVertexAttribPointer gl_loader_glVertexAttribPointer
+extern PFNGLVIEWPORTPROC gl_loader_glViewport;
+#define glViewport gl_loader_glViewport
@@ -0,0 +1,440 @@
+/* Generated by gen_gl_loader.py from glcorearb.h and gl_loader.txt; do not edit. */
+#include "replay.h"
+
+bool gl_replay_call(unsigned int id)
+{
+    switch (id) {
+    case 0: {
+        GLuint c_program = replay_u32();
+        GLuint c_shader = replay_u32();
+        glAttachShader((GLuint) replay_name(REPLAY_PROGRAM, c_program), (GLuint) replay_name(REPLAY_SHADER, c_shader));
+        return true;
+    }
+    case 1: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLuint c_buffer = replay_u32();
+        glBindBuffer(c_target, (GLuint) replay_name(REPLAY_BUFFER, c_buffer));
+        return true;
+    }
+    case 2: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLuint c_index = (GLuint) replay_u32();
+        GLuint c_buffer = replay_u32();
+        GLintptr c_offset = (GLintptr) replay_u64();
+        GLsizeiptr c_size = (GLsizeiptr) replay_u64();
+        glBindBufferRange(c_target, c_index, (GLuint) replay_name(REPLAY_BUFFER, c_buffer), c_offset, c_size);
+        return true;
+    }
+    case 3: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLuint c_framebuffer = replay_u32();
+        glBindFramebuffer(c_target, (GLuint) replay_name(REPLAY_FRAMEBUFFER, c_framebuffer));
+        return true;
+    }
+    case 4: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLuint c_renderbuffer = replay_u32();
+        glBindRenderbuffer(c_target, (GLuint) replay_name(REPLAY_RENDERBUFFER, c_renderbuffer));
+        return true;
+    }
+    case 5: {
+        GLuint c_array = replay_u32();
+        glBindVertexArray((GLuint) replay_name(REPLAY_VERTEX_ARRAY, c_array));
+        return true;
+    }
+    case 6: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLsizeiptr c_size = (GLsizeiptr) replay_u64();
+        const void *c_data = replay_bytes();
+        GLenum c_usage = (GLenum) replay_u32();
+        glBufferData(c_target, c_size, c_data, c_usage);
+        return true;
+    }
+    case 7: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLsizeiptr c_size = (GLsizeiptr) replay_u64();
+        const void *c_data = replay_bytes();
+        GLbitfield c_flags = (GLbitfield) replay_u32();
+        glBufferStorage(c_target, c_size, c_data, c_flags);
+        return true;
+    }
+    case 8: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLintptr c_offset = (GLintptr) replay_u64();
+        GLsizeiptr c_size = (GLsizeiptr) replay_u64();
+        const void *c_data = replay_bytes();
+        glBufferSubData(c_target, c_offset, c_size, c_data);
+        return true;
+    }
+    case 9: {
+        GLenum c_target = (GLenum) replay_u32();
+        glCheckFramebufferStatus(c_target);
+        return true;
+    }
+    case 10: {
+        GLbitfield c_mask = (GLbitfield) replay_u32();
+        glClear(c_mask);
+        return true;
+    }
+    case 11: {
+        GLfloat c_red = replay_f32();
+        GLfloat c_green = replay_f32();
+        GLfloat c_blue = replay_f32();
+        GLfloat c_alpha = replay_f32();
+        glClearColor(c_red, c_green, c_blue, c_alpha);
+        return true;
+    }
+    case 12: {
+        uint64_t c_sync = replay_u64();
+        GLbitfield c_flags = (GLbitfield) replay_u32();
+        GLuint64 c_timeout = (GLuint64) replay_u64();
+        glClientWaitSync((GLsync) (uintptr_t) replay_name(REPLAY_SYNC, c_sync), c_flags, c_timeout);
+        return true;
+    }
+    case 13: {
+        GLuint c_shader = replay_u32();
+        glCompileShader((GLuint) replay_name(REPLAY_SHADER, c_shader));
+        return true;
+    }
+    case 14: {
+        GLenum c_readTarget = (GLenum) replay_u32();
+        GLenum c_writeTarget = (GLenum) replay_u32();
+        GLintptr c_readOffset = (GLintptr) replay_u64();
+        GLintptr c_writeOffset = (GLintptr) replay_u64();
+        GLsizeiptr c_size = (GLsizeiptr) replay_u64();
+        glCopyBufferSubData(c_readTarget, c_writeTarget, c_readOffset, c_writeOffset, c_size);
+        return true;
+    }
+    case 15: {
+        GLuint result = glCreateProgram();
+        replay_bind_name(REPLAY_PROGRAM, replay_u32(), result);
+        return true;
+    }
+    case 16: {
+        GLenum c_type = (GLenum) replay_u32();
+        GLuint result = glCreateShader(c_type);
+        replay_bind_name(REPLAY_SHADER, replay_u32(), result);
+        return true;
+    }
+    case 17: {
+        glDebugMessageCallback(NULL, NULL);
+        return true;
+    }
+    case 18: {
+        GLenum c_source = (GLenum) replay_u32();
+        GLenum c_type = (GLenum) replay_u32();
+        GLenum c_severity = (GLenum) replay_u32();
+        GLsizei c_count = (GLsizei) replay_u32();
+        const GLuint *c_ids = replay_bytes();
+        GLboolean c_enabled = (GLboolean) replay_u32();
+        glDebugMessageControl(c_source, c_type, c_severity, c_count, c_ids, c_enabled);
+        return true;
+    }
+    case 19: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_buffers = replay_names(REPLAY_BUFFER, c_n);
+        glDeleteBuffers(c_n, c_buffers);
+        return true;
+    }
+    case 20: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_framebuffers = replay_names(REPLAY_FRAMEBUFFER, c_n);
+        glDeleteFramebuffers(c_n, c_framebuffers);
+        return true;
+    }
+    case 21: {
+        GLuint c_program = replay_u32();
+        glDeleteProgram((GLuint) replay_name(REPLAY_PROGRAM, c_program));
+        return true;
+    }
+    case 22: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_ids = replay_names(REPLAY_QUERY, c_n);
+        glDeleteQueries(c_n, c_ids);
+        return true;
+    }
+    case 23: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_renderbuffers = replay_names(REPLAY_RENDERBUFFER, c_n);
+        glDeleteRenderbuffers(c_n, c_renderbuffers);
+        return true;
+    }
+    case 24: {
+        GLuint c_shader = replay_u32();
+        glDeleteShader((GLuint) replay_name(REPLAY_SHADER, c_shader));
+        return true;
+    }
+    case 25: {
+        uint64_t c_sync = replay_u64();
+        glDeleteSync((GLsync) (uintptr_t) replay_name(REPLAY_SYNC, c_sync));
+        return true;
+    }
+    case 26: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_arrays = replay_names(REPLAY_VERTEX_ARRAY, c_n);
+        glDeleteVertexArrays(c_n, c_arrays);
+        return true;
+    }
+    case 27: {
+        GLuint c_program = replay_u32();
+        GLuint c_shader = replay_u32();
+        glDetachShader((GLuint) replay_name(REPLAY_PROGRAM, c_program), (GLuint) replay_name(REPLAY_SHADER, c_shader));
+        return true;
+    }
+    case 28: {
+        GLenum c_mode = (GLenum) replay_u32();
+        GLsizei c_count = (GLsizei) replay_u32();
+        GLenum c_type = (GLenum) replay_u32();
+        const void *c_indices = (const void *) (uintptr_t) replay_u64();
+        glDrawElements(c_mode, c_count, c_type, c_indices);
+        return true;
+    }
+    case 29: {
+        GLenum c_cap = (GLenum) replay_u32();
+        glEnable(c_cap);
+        return true;
+    }
+    case 30: {
+        GLuint c_index = (GLuint) replay_u32();
+        glEnableVertexAttribArray(c_index);
+        return true;
+    }
+    case 31: {
+        GLenum c_condition = (GLenum) replay_u32();
+        GLbitfield c_flags = (GLbitfield) replay_u32();
+        GLsync result = glFenceSync(c_condition, c_flags);
+        replay_bind_name(REPLAY_SYNC, replay_u64(), (uint64_t) (uintptr_t) result);
+        return true;
+    }
+    case 32: {
+        glFinish();
+        return true;
+    }
+    case 33: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLintptr c_offset = (GLintptr) replay_u64();
+        GLsizeiptr c_length = (GLsizeiptr) replay_u64();
+        glFlushMappedBufferRange(c_target, c_offset, c_length);
+        return true;
+    }
+    case 34: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLenum c_attachment = (GLenum) replay_u32();
+        GLenum c_renderbuffertarget = (GLenum) replay_u32();
+        GLuint c_renderbuffer = replay_u32();
+        glFramebufferRenderbuffer(c_target, c_attachment, c_renderbuffertarget, (GLuint) replay_name(REPLAY_RENDERBUFFER, c_renderbuffer));
+        return true;
+    }
+    case 35: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_buffers = replay_scratch(c_n);
+        glGenBuffers(c_n, c_buffers);
+        replay_bind_names(REPLAY_BUFFER, c_n, c_buffers);
+        return true;
+    }
+    case 36: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_framebuffers = replay_scratch(c_n);
+        glGenFramebuffers(c_n, c_framebuffers);
+        replay_bind_names(REPLAY_FRAMEBUFFER, c_n, c_framebuffers);
+        return true;
+    }
+    case 37: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_ids = replay_scratch(c_n);
+        glGenQueries(c_n, c_ids);
+        replay_bind_names(REPLAY_QUERY, c_n, c_ids);
+        return true;
+    }
+    case 38: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_renderbuffers = replay_scratch(c_n);
+        glGenRenderbuffers(c_n, c_renderbuffers);
+        replay_bind_names(REPLAY_RENDERBUFFER, c_n, c_renderbuffers);
+        return true;
+    }
+    case 39: {
+        GLsizei c_n = (GLsizei) replay_u32();
+        GLuint *c_arrays = replay_scratch(c_n);
+        glGenVertexArrays(c_n, c_arrays);
+        replay_bind_names(REPLAY_VERTEX_ARRAY, c_n, c_arrays);
+        return true;
+    }
+    case 40: {
+        glGetError();
+        return true;
+    }
+    case 41: {
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_data = replay_out(0);
+        glGetInteger64v(c_pname, c_data);
+        return true;
+    }
+    case 42: {
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_data = replay_out(0);
+        glGetIntegerv(c_pname, c_data);
+        return true;
+    }
+    case 43: {
+        GLuint c_program = replay_u32();
+        GLsizei c_bufSize = (GLsizei) replay_u32();
+        void *c_length = replay_out(0);
+        void *c_infoLog = replay_out(1);
+        glGetProgramInfoLog((GLuint) replay_name(REPLAY_PROGRAM, c_program), c_bufSize < REPLAY_OUT_SIZE ? c_bufSize : REPLAY_OUT_SIZE, c_length, c_infoLog);
+        return true;
+    }
+    case 44: {
+        GLuint c_program = replay_u32();
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_params = replay_out(0);
+        glGetProgramiv((GLuint) replay_name(REPLAY_PROGRAM, c_program), c_pname, c_params);
+        return true;
+    }
+    case 45: {
+        GLuint c_id = replay_u32();
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_params = replay_out(0);
+        glGetQueryObjectiv((GLuint) replay_name(REPLAY_QUERY, c_id), c_pname, c_params);
+        return true;
+    }
+    case 46: {
+        GLuint c_id = replay_u32();
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_params = replay_out(0);
+        glGetQueryObjectui64v((GLuint) replay_name(REPLAY_QUERY, c_id), c_pname, c_params);
+        return true;
+    }
+    case 47: {
+        GLuint c_shader = replay_u32();
+        GLsizei c_bufSize = (GLsizei) replay_u32();
+        void *c_length = replay_out(0);
+        void *c_infoLog = replay_out(1);
+        glGetShaderInfoLog((GLuint) replay_name(REPLAY_SHADER, c_shader), c_bufSize < REPLAY_OUT_SIZE ? c_bufSize : REPLAY_OUT_SIZE, c_length, c_infoLog);
+        return true;
+    }
+    case 48: {
+        GLuint c_shader = replay_u32();
+        GLenum c_pname = (GLenum) replay_u32();
+        void *c_params = replay_out(0);
+        glGetShaderiv((GLuint) replay_name(REPLAY_SHADER, c_shader), c_pname, c_params);
+        return true;
+    }
+    case 49: {
+        GLenum c_name = (GLenum) replay_u32();
+        glGetString(c_name);
+        return true;
+    }
+    case 50: {
+        GLenum c_name = (GLenum) replay_u32();
+        GLuint c_index = (GLuint) replay_u32();
+        glGetStringi(c_name, c_index);
+        return true;
+    }
+    case 51: {
+        GLuint c_program = replay_u32();
+        const GLchar *c_uniformBlockName = replay_string();
+        glGetUniformBlockIndex((GLuint) replay_name(REPLAY_PROGRAM, c_program), c_uniformBlockName);
+        return true;
+    }
+    case 52: {
+        GLuint c_program = replay_u32();
+        const GLchar *c_name = replay_string();
+        GLint result = glGetUniformLocation((GLuint) replay_name(REPLAY_PROGRAM, c_program), c_name);
+        replay_bind_location(c_program, (GLint) replay_u32(), result);
+        return true;
+    }
+    case 53: {
+        GLuint c_program = replay_u32();
+        glLinkProgram((GLuint) replay_name(REPLAY_PROGRAM, c_program));
+        return true;
+    }
+    case 54: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLintptr c_offset = (GLintptr) replay_u64();
+        GLsizeiptr c_length = (GLsizeiptr) replay_u64();
+        GLbitfield c_access = (GLbitfield) replay_u32();
+        glMapBufferRange(c_target, c_offset, c_length, c_access);
+        return true;
+    }
+    case 55: {
+        GLenum c_identifier = (GLenum) replay_u32();
+        GLuint c_name = replay_u32();
+        const GLchar *c_label = replay_string();
+        glObjectLabel(c_identifier, replay_object(c_identifier, c_name), -1, c_label);
+        return true;
+    }
+    case 56: {
+        GLuint c_id = replay_u32();
+        GLenum c_target = (GLenum) replay_u32();
+        glQueryCounter((GLuint) replay_name(REPLAY_QUERY, c_id), c_target);
+        return true;
+    }
+    case 57: {
+        GLenum c_target = (GLenum) replay_u32();
+        GLenum c_internalformat = (GLenum) replay_u32();
+        GLsizei c_width = (GLsizei) replay_u32();
+        GLsizei c_height = (GLsizei) replay_u32();
+        glRenderbufferStorage(c_target, c_internalformat, c_width, c_height);
+        return true;
+    }
+    case 58: {
+        GLuint c_shader = replay_u32();
+        const GLchar *c_string = replay_string();
+        glShaderSource((GLuint) replay_name(REPLAY_SHADER, c_shader), 1, &c_string, NULL);
+        return true;
+    }
+    case 59: {
+        GLuint c_program = replay_u32();
+        GLuint c_uniformBlockIndex = (GLuint) replay_u32();
+        GLuint c_uniformBlockBinding = (GLuint) replay_u32();
+        glUniformBlockBinding((GLuint) replay_name(REPLAY_PROGRAM, c_program), c_uniformBlockIndex, c_uniformBlockBinding);
+        return true;
+    }
+    case 60: {
+        GLint c_location = (GLint) replay_u32();
+        GLsizei c_count = (GLsizei) replay_u32();
+        GLboolean c_transpose = (GLboolean) replay_u32();
+        const GLfloat *c_value = replay_bytes();
+        glUniformMatrix4fv(replay_location(c_location), c_count, c_transpose, c_value);
+        return true;
+    }
+    case 61: {
+        GLenum c_target = (GLenum) replay_u32();
+        glUnmapBuffer(c_target);
+        return true;
+    }
+    case 62: {
+        GLuint c_program = replay_u32();
+        glUseProgram((GLuint) replay_name(REPLAY_PROGRAM, c_program));
+        replay_use_program(c_program);
+        return true;
+    }
+    case 63: {
+        GLuint c_index = (GLuint) replay_u32();
+        GLuint c_divisor = (GLuint) replay_u32();
+        glVertexAttribDivisor(c_index, c_divisor);
+        return true;
+    }
+    case 64: {
+        GLuint c_index = (GLuint) replay_u32();
+        GLint c_size = (GLint) replay_u32();
+        GLenum c_type = (GLenum) replay_u32();
+        GLboolean c_normalized = (GLboolean) replay_u32();
+        GLsizei c_stride = (GLsizei) replay_u32();
+        const void *c_pointer = (const void *) (uintptr_t) replay_u64();
+        glVertexAttribPointer(c_index, c_size, c_type, c_normalized, c_stride, c_pointer);
+        return true;
+    }
+    case 65: {
+        GLint c_x = (GLint) replay_u32();
+        GLint c_y = (GLint) replay_u32();
+        GLsizei c_width = (GLsizei) replay_u32();
+        GLsizei c_height = (GLsizei) replay_u32();
+        glViewport(c_x, c_y, c_width, c_height);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
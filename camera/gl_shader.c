@@ -1,4 +1,6 @@
 #include "gl_shader.h"
+#include "gl_debug.h"
+#include "metrics.h"
 
 long file_size(FILE *fp)
 {
@@ -78,6 +80,7 @@ void shader_load(Shader *shader, const char *vertex_fp, const char *fragment_fp)
     printf("Compiling...\n");
     glCompileShader(shader->vertex);
     glCompileShader(shader->fragment);
+    metrics_add(METRIC_SHADER_COMPILES, 2);
 
     /* Link it */
     if (!(shader->program = glCreateProgram())) {
@@ -116,6 +119,8 @@ GLuint gl_create_shader(GLenum shader_type, const char *shader_str) {
 	}
 	glShaderSource(shader, 1, &shader_str, NULL);
 	glCompileShader(shader);
+	metrics_add(METRIC_SHADER_COMPILES, 1);
+	gl_debug_label(GL_SHADER, shader, shader_type == GL_VERTEX_SHADER ? "vertex shader %u" : "fragment shader %u", shader);
 
 	// Get shader status
 	{
@@ -157,6 +162,7 @@ GLuint gl_create_program(const GLuint *const shaders, int nshaders) {
 	for (int i = 0; i < nshaders; ++i)
 		glAttachShader(program, shaders[i]);
 	glLinkProgram(program);
+	gl_debug_label(GL_PROGRAM, program, "program %u", program);
 
 	// Get program status
 	{
@@ -220,3 +226,14 @@ GLuint gl_create_program_from_str(const char *vert_shader_str, const char *frag_
 
 	return prog;
 }
+
+/* GLSL 330 has no layout(binding), so blocks get their binding point here. */
+bool gl_uniform_block_binding(GLuint program, const char *block_name, GLuint binding) {
+	GLuint index = glGetUniformBlockIndex(program, block_name);
+	if (index == GL_INVALID_INDEX) {
+		log_error("Program %u has no uniform block %s.", program, block_name);
+		return false;
+	}
+	glUniformBlockBinding(program, index, binding);
+	return true;
+}
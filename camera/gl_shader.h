@@ -2,9 +2,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <GL/glew.h>
-#include <GL/gl.h>
-#include <GL/glu.h>
+#include "gl_loader.h"
 #include "log.h"
 
 
@@ -32,3 +30,4 @@ void shader_destroy(Shader *shader);
 GLuint gl_create_shader(GLenum shader_type, const char *shader_str);
 GLuint gl_create_program(const GLuint *const shaders, int nshaders);
 GLuint gl_create_program_from_str(const char *vert_shader_str, const char *frag_shader_str);
+bool gl_uniform_block_binding(GLuint program, const char *block_name, GLuint binding);
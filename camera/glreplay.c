@@ -0,0 +1,207 @@
+#include "replay.h"
+#include "capture.h"
+#include "window.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static unsigned char *read_file(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char *data = len > 0 ? malloc(len) : NULL;
+    if (!data || fread(data, 1, len, f) != (size_t) len) {
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = len;
+    return data;
+}
+
+/* Captured call ids to ours, by name, so captures survive loader changes
+ * that only add or reorder entry points. */
+static int *id_map;
+static unsigned int id_count;
+
+static void replay_call(uint16_t id)
+{
+    if (id >= id_count || id_map[id] < 0 || !gl_replay_call(id_map[id])) {
+        log_fatal("replay: unknown call %u at byte %zu", id, replay_tell());
+        exit(1);
+    }
+}
+
+/* Runs calls up to the next frame marker or limit; returns the call count. */
+static unsigned long replay_until(size_t limit, bool *frame)
+{
+    unsigned long calls = 0;
+    *frame = false;
+    while (replay_tell() < limit) {
+        uint16_t id = replay_call_id();
+        if (id == CAPTURE_FRAME) {
+            *frame = true;
+            break;
+        }
+        replay_call(id);
+        calls++;
+    }
+    return calls;
+}
+
+static void report(const char *what, double *ms, unsigned long count)
+{
+    qsort(ms, count, sizeof(double), cmp_double);
+    log_info("replay: %s ms: min %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f", what,
+             ms[0], ms[count * 50 / 100], ms[count * 90 / 100], ms[count * 99 / 100], ms[count - 1]);
+}
+
+/* Replays a capture offscreen. The first frame, which holds startup and
+ * resource creation, runs once; frames 2..n then run --loop times, each
+ * ending in glFinish(), and the teardown runs at the end. Reports per-frame
+ * submission time (issuing the calls) and completion time. */
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    unsigned long loops = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--loop") && i + 1 < argc)
+            loops = strtoul(argv[++i], NULL, 10);
+        else if (!path)
+            path = argv[i];
+        else
+            path = NULL, i = argc;
+    }
+    if (!path || !loops) {
+        fprintf(stderr, "usage: glreplay capture.bin [--loop n]\n");
+        return 2;
+    }
+    /* Don't capture the replay. */
+    unsetenv("GL_CAPTURE");
+
+    size_t size;
+    unsigned char *data = read_file(path, &size);
+    if (!data) {
+        log_error("replay: can't read %s", path);
+        return 1;
+    }
+
+    uint32_t header[5];
+    uint64_t frames_end;
+    size_t at = 8 + sizeof(header) + sizeof(frames_end);
+    if (size < at || memcmp(data, CAPTURE_MAGIC, 8)) {
+        log_error("replay: %s is not a GL capture", path);
+        return 1;
+    }
+    memcpy(header, data + 8, sizeof(header));
+    memcpy(&frames_end, data + 8 + sizeof(header), sizeof(frames_end));
+    if (header[0] != CAPTURE_VERSION) {
+        log_error("replay: %s is version %u, expected %u", path, header[0], CAPTURE_VERSION);
+        return 1;
+    }
+    int width = header[1], height = header[2];
+    unsigned long frames = header[3];
+    id_count = header[4];
+
+    id_map = malloc(sizeof(int) * (id_count ? id_count : 1));
+    if (!id_map) {
+        log_error("replay: out of memory for %u call names", id_count);
+        return 1;
+    }
+    /* Unknown names stay -1 and fail in replay_call() if they are used. */
+    for (unsigned int i = 0; i < id_count; i++)
+        id_map[i] = -1;
+    bool truncated = false;
+    for (unsigned int i = 0; i < id_count; i++) {
+        uint16_t len;
+        if (size - at < sizeof(len)) {
+            truncated = true;
+            break;
+        }
+        memcpy(&len, data + at, sizeof(len));
+        at += sizeof(len);
+        if (size - at < len) {
+            truncated = true;
+            break;
+        }
+        for (unsigned int j = 0; j < gl_loader_count; j++)
+            if (strlen(gl_loader_names[j]) == len && !memcmp(gl_loader_names[j], data + at, len))
+                id_map[i] = j;
+        at += len;
+    }
+    at += -at & 7;
+    if (truncated || at > size || frames_end > size - at) {
+        log_error("replay: %s is truncated", path);
+        return 1;
+    }
+
+    struct Window *w = init_headless_window(width, height, 0);
+    replay_open(data + at, size - at);
+    log_info("replay: %s, %lu frames at %dx%d", path, frames, width, height);
+
+    bool frame;
+    double t = now();
+    unsigned long setup_calls = replay_until(frames_end, &frame);
+    glFinish();
+    log_info("replay: first frame, %lu calls, %.2f ms", setup_calls, (now() - t) * 1e3);
+
+    size_t first = replay_tell();
+    unsigned long looped = frames > 1 ? (frames - 1) * loops : 0;
+    double *submit_ms = malloc(sizeof(double) * (looped ? looped : 1));
+    double *frame_ms = malloc(sizeof(double) * (looped ? looped : 1));
+    if (!submit_ms || !frame_ms) {
+        log_error("replay: out of memory for %lu frame times", looped);
+        return 1;
+    }
+    unsigned long calls = 0, n = 0;
+
+    for (unsigned long l = 0; l < loops && looped; l++) {
+        replay_seek(first);
+        while (replay_tell() < frames_end && n < looped) {
+            double t0 = now();
+            calls += replay_until(frames_end, &frame);
+            double t1 = now();
+            glFinish();
+            submit_ms[n] = (t1 - t0) * 1e3;
+            frame_ms[n++] = (now() - t0) * 1e3;
+        }
+    }
+    if (n) {
+        log_info("replay: %lu frames, %.1f calls/frame", n, (double) calls / n);
+        report("submit", submit_ms, n);
+        report("frame", frame_ms, n);
+    } else {
+        log_info("replay: no frames to loop");
+    }
+
+    replay_seek(frames_end);
+    replay_until(size - at, &frame);
+
+    free(submit_ms);
+    free(frame_ms);
+    destroy_window(w);
+    free(data);
+    free(id_map);
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "gpumem.h"
+#include "metrics.h"
+#include "log.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct {
+    uint64_t key;               /* kind + 1 above the name, 0 marks a free slot */
+    GpuCategory category;
+    size_t bytes;
+} Allocation;
+
+static const char *category_names[GPUMEM_CATEGORY_COUNT] = {
+    [GPUMEM_VERTICES] = "vertices",
+    [GPUMEM_INDICES] = "indices",
+    [GPUMEM_INSTANCES] = "instances",
+    [GPUMEM_TEXTURES] = "textures",
+    [GPUMEM_TARGETS] = "targets",
+    [GPUMEM_STREAMING] = "streaming",
+};
+
+static const char *kind_names[] = {"buffer", "texture", "renderbuffer"};
+
+static struct {
+    Allocation *table;
+    size_t count, capacity;     /* capacity is a power of two */
+    size_t used, peak;
+    size_t category_used[GPUMEM_CATEGORY_COUNT], category_peak[GPUMEM_CATEGORY_COUNT];
+    size_t budget;
+    GpuStream *head, *tail;
+    unsigned long frame, evictions;
+    bool over_budget;           /* warned about the current overrun */
+} mem;
+
+void gpumem_init(void)
+{
+    const char *env = getenv("GPU_BUDGET_MB");
+    mem.budget = env ? strtoull(env, NULL, 10) << 20 : 0;
+    if (mem.budget)
+        log_info("gpumem: budget %zu MiB", mem.budget >> 20);
+}
+
+static size_t slot(uint64_t key)
+{
+    size_t i = (key * UINT64_C(0x9e3779b97f4a7c15)) >> 32 & (mem.capacity - 1);
+    while (mem.table[i].key && mem.table[i].key != key)
+        i = (i + 1) & (mem.capacity - 1);
+    return i;
+}
+
+static void grow(void)
+{
+    Allocation *old = mem.table;
+    size_t old_capacity = mem.capacity;
+    mem.capacity = old_capacity ? old_capacity * 2 : 256;
+    mem.table = calloc(mem.capacity, sizeof(Allocation));
+    if (!mem.table) {
+        log_fatal("gpumem: out of memory tracking %zu allocations", mem.count);
+        exit(1);
+    }
+    for (size_t i = 0; i < old_capacity; i++)
+        if (old[i].key)
+            mem.table[slot(old[i].key)] = old[i];
+    free(old);
+}
+
+static void account(GpuCategory category, size_t add, size_t remove)
+{
+    mem.used += add - remove;
+    mem.category_used[category] += add - remove;
+    if (mem.used > mem.peak)
+        mem.peak = mem.used;
+    if (mem.category_used[category] > mem.category_peak[category])
+        mem.category_peak[category] = mem.category_used[category];
+    metrics_set(METRIC_GPU_BYTES, mem.used);
+}
+
+void gpumem_alloc(GpuKind kind, GLuint name, GpuCategory category, size_t bytes)
+{
+    if ((mem.count + 1) * 2 > mem.capacity)
+        grow();
+    uint64_t key = (uint64_t) (kind + 1) << 32 | name;
+    Allocation *a = &mem.table[slot(key)];
+    if (a->key) {
+        account(a->category, 0, a->bytes);
+    } else {
+        a->key = key;
+        mem.count++;
+    }
+    a->category = category;
+    a->bytes = bytes;
+    account(category, bytes, 0);
+}
+
+/* Linear probing with backward-shift deletion, so lookups never need
+ * tombstones. Freeing an untracked name is a no-op, like glDelete*. */
+void gpumem_free(GpuKind kind, GLuint name)
+{
+    if (!mem.count)
+        return;
+    uint64_t key = (uint64_t) (kind + 1) << 32 | name;
+    size_t i = slot(key);
+    if (!mem.table[i].key)
+        return;
+    account(mem.table[i].category, 0, mem.table[i].bytes);
+    mem.count--;
+
+    for (size_t j = i;;) {
+        mem.table[i].key = 0;
+        for (;;) {
+            j = (j + 1) & (mem.capacity - 1);
+            if (!mem.table[j].key)
+                return;
+            size_t home = (mem.table[j].key * UINT64_C(0x9e3779b97f4a7c15)) >> 32 & (mem.capacity - 1);
+            /* Move j back into the hole unless its home lies cyclically in (i, j]. */
+            if (i <= j ? (home <= i || home > j) : (home <= i && home > j))
+                break;
+        }
+        mem.table[i] = mem.table[j];
+        i = j;
+    }
+}
+
+size_t gpumem_used(void)
+{
+    return mem.used;
+}
+
+const char *gpumem_category_name(GpuCategory category)
+{
+    return category_names[category];
+}
+
+static void unlink_stream(GpuStream *s)
+{
+    if (s->prev)
+        s->prev->next = s->next;
+    else
+        mem.head = s->next;
+    if (s->next)
+        s->next->prev = s->prev;
+    else
+        mem.tail = s->prev;
+    s->prev = s->next = NULL;
+}
+
+static void push_front(GpuStream *s)
+{
+    s->prev = NULL;
+    s->next = mem.head;
+    if (mem.head)
+        mem.head->prev = s;
+    else
+        mem.tail = s;
+    mem.head = s;
+}
+
+void gpumem_stream_add(GpuStream *s, size_t (*evict)(GpuStream *s))
+{
+    if (s->linked)
+        return;
+    s->evict = evict;
+    s->last_used = mem.frame;
+    s->linked = true;
+    push_front(s);
+}
+
+void gpumem_stream_remove(GpuStream *s)
+{
+    if (!s->linked)
+        return;
+    unlink_stream(s);
+    s->linked = false;
+}
+
+void gpumem_touch(GpuStream *s)
+{
+    s->last_used = mem.frame;
+    if (s->linked && mem.head != s) {
+        unlink_stream(s);
+        push_front(s);
+    }
+}
+
+/* Ends a frame: evicts from the cold end of the list until usage fits the
+ * budget or only resources touched this frame are left. Resources that
+ * would free nothing are skipped and stay where they are. */
+void gpumem_frame(void)
+{
+    GpuStream *s = mem.tail;
+    while (mem.budget && mem.used > mem.budget) {
+        if (!s || s->last_used == mem.frame) {
+            if (!mem.over_budget)
+                log_warn("gpumem: %zu KiB in use this frame, over the %zu KiB budget",
+                         mem.used >> 10, mem.budget >> 10);
+            mem.over_budget = true;
+            break;
+        }
+        GpuStream *prev = s->prev;
+        if (s->evict(s)) {
+            gpumem_stream_remove(s);
+            mem.evictions++;
+            metrics_add(METRIC_GPU_EVICTIONS, 1);
+        }
+        s = prev;
+    }
+    if (mem.used <= mem.budget)
+        mem.over_budget = false;
+    mem.frame++;
+}
+
+void gpumem_shutdown(void)
+{
+    log_info("gpumem: peak %.1f KiB, %lu evictions", mem.peak / 1024.0, mem.evictions);
+    for (int i = 0; i < GPUMEM_CATEGORY_COUNT; i++)
+        if (mem.category_peak[i])
+            log_info("gpumem:   %-10s peak %10.1f KiB, live %10.1f KiB", category_names[i],
+                     mem.category_peak[i] / 1024.0, mem.category_used[i] / 1024.0);
+
+    if (mem.count)
+        log_warn("gpumem: %zu allocations, %zu bytes never freed", mem.count, mem.used);
+    size_t listed = 0;
+    for (size_t i = 0; i < mem.capacity && listed < GPUMEM_LEAKS_LISTED; i++) {
+        const Allocation *a = &mem.table[i];
+        if (!a->key)
+            continue;
+        log_warn("gpumem:   leaked %s %u (%s), %zu bytes", kind_names[(a->key >> 32) - 1],
+                 (unsigned int) a->key, category_names[a->category], a->bytes);
+        listed++;
+    }
+
+    free(mem.table);
+    mem.table = NULL;
+    mem.count = mem.capacity = 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "gl_loader.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#define GPUMEM_LEAKS_LISTED 16      /* live allocations itemised at shutdown */
+
+/* Object namespaces; names are only unique within one. */
+typedef enum {
+    GPUMEM_BUFFER,
+    GPUMEM_TEXTURE,
+    GPUMEM_RENDERBUFFER
+} GpuKind;
+
+typedef enum {
+    GPUMEM_VERTICES,
+    GPUMEM_INDICES,
+    GPUMEM_INSTANCES,
+    GPUMEM_TEXTURES,
+    GPUMEM_TARGETS,             /* framebuffer attachments */
+    GPUMEM_STREAMING,           /* per-frame ring, see stream.h */
+    GPUMEM_CATEGORY_COUNT
+} GpuCategory;
+
+/* A resource that can be dropped from GPU memory and brought back later,
+ * embedded in its owner. evict() must free the owner's GL objects, which
+ * gpumem_free()s them, leave it able to restore itself on next use and
+ * return the bytes freed. When nothing would be freed, for example because
+ * the objects are shared, it returns 0 and leaves the owner resident. */
+typedef struct GpuStream {
+    struct GpuStream *prev, *next;      /* most recently used first */
+    size_t (*evict)(struct GpuStream *s);
+    unsigned long last_used;            /* gpumem frame of the last touch */
+    bool linked;
+} GpuStream;
+
+/* GPU memory accounting and budget.
+ *
+ * Every buffer, texture and renderbuffer allocation is reported with
+ * gpumem_alloc() (a second call for the same object replaces its size,
+ * as glBufferData does) and gpumem_free() when deleted, and is accounted
+ * by category. $GPU_BUDGET_MB sets a budget (default 0, unlimited): at
+ * each gpumem_frame() streamable resources not touched that frame are
+ * evicted, least recently used first, until usage is back under it.
+ * Resources in use are never evicted, so a frame that needs more than the
+ * budget still draws, and logs a warning. gpumem_shutdown() logs the peak
+ * usage per category and every allocation still alive as a leak. Render
+ * thread only. */
+void gpumem_init(void);
+void gpumem_shutdown(void);
+void gpumem_alloc(GpuKind kind, GLuint name, GpuCategory category, size_t bytes);
+void gpumem_free(GpuKind kind, GLuint name);
+size_t gpumem_used(void);
+const char *gpumem_category_name(GpuCategory category);
+
+void gpumem_stream_add(GpuStream *s, size_t (*evict)(GpuStream *s));
+void gpumem_stream_remove(GpuStream *s);
+void gpumem_touch(GpuStream *s);
+void gpumem_frame(void);
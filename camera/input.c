@@ -0,0 +1,63 @@
+#include "input.h"
+#include <string.h>
+
+void input_init(InputRing *r)
+{
+    memset(r, 0, sizeof(*r));
+}
+
+/* Producer side. Never blocks; a full ring drops the event. */
+bool input_push(InputRing *r, const InputEvent *e)
+{
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (head - tail == INPUT_RING_SIZE) {
+        r->dropped++;
+        return false;
+    }
+    r->events[head & (INPUT_RING_SIZE - 1)] = *e;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return true;
+}
+
+/* Consumer side. Applies every event stamped at or before until to s, so
+ * each simulation tick only sees input that happened before it ended.
+ * Mouse motion accumulates until input_take_mouse(). */
+unsigned int input_drain(InputRing *r, InputState *s, double until)
+{
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_acquire);
+    unsigned int n = 0;
+
+    for (; tail != head; tail++, n++) {
+        const InputEvent *e = &r->events[tail & (INPUT_RING_SIZE - 1)];
+        if (e->time > until)
+            break;
+
+        switch (e->type) {
+        case INPUT_KEY_DOWN:
+            s->keys[e->key >> 6] |= UINT64_C(1) << (e->key & 63);
+            break;
+        case INPUT_KEY_UP:
+            s->keys[e->key >> 6] &= ~(UINT64_C(1) << (e->key & 63));
+            break;
+        case INPUT_MOUSE_MOVE:
+            s->dx += e->dx;
+            s->dy += e->dy;
+            break;
+        }
+        s->last_time = e->time;
+    }
+
+    atomic_store_explicit(&r->tail, tail, memory_order_release);
+    s->events += n;
+    return n;
+}
+
+void input_take_mouse(InputState *s, float *dx, float *dy)
+{
+    *dx = s->dx;
+    *dy = s->dy;
+    s->dx = s->dy = 0.0f;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_RING_SIZE 1024    /* power of two */
+#define INPUT_KEYS 1024
+
+typedef enum {
+    INPUT_KEY_DOWN,
+    INPUT_KEY_UP,
+    INPUT_MOUSE_MOVE
+} InputType;
+
+typedef struct {
+    double time;        /* glfwGetTime() when the callback fired */
+    InputType type;
+    int key;
+    float dx, dy;       /* INPUT_MOUSE_MOVE only */
+} InputEvent;
+
+/* Single-producer/single-consumer ring: the window callbacks push, the
+ * simulation drains, possibly from another thread. Head and tail sit on
+ * separate cache lines so the two sides don't false-share. */
+typedef struct {
+    _Alignas(64) atomic_uint head;      /* next slot to write, producer only */
+    _Alignas(64) atomic_uint tail;      /* next slot to read, consumer only */
+    unsigned long dropped;              /* events lost to a full ring, producer only */
+    InputEvent events[INPUT_RING_SIZE];
+} InputRing;
+
+/* What the consumer has seen so far. */
+typedef struct {
+    uint64_t keys[INPUT_KEYS / 64];
+    float dx, dy;                       /* mouse motion not yet taken */
+    double last_time;                   /* timestamp of the newest drained event */
+    unsigned long events;
+} InputState;
+
+void input_init(InputRing *r);
+bool input_push(InputRing *r, const InputEvent *e);
+unsigned int input_drain(InputRing *r, InputState *s, double until);
+void input_take_mouse(InputState *s, float *dx, float *dy);
+
+static inline bool input_any_key(const InputState *s)
+{
+    for (int i = 0; i < INPUT_KEYS / 64; i++)
+        if (s->keys[i])
+            return true;
+    return false;
+}
+
+static inline bool input_key(const InputState *s, int key)
+{
+    return key >= 0 && key < INPUT_KEYS && (s->keys[key >> 6] >> (key & 63) & 1);
+}
@@ -0,0 +1,443 @@
+#include "job.h"
+#include "log.h"
+#include "profile.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SPIN_BEFORE_SLEEP 256
+#define PARALLEL_FOR_MAX_CHUNKS 256
+
+/* Chase-Lev work-stealing deque: the owner pushes and pops at the bottom,
+ * thieves take from the top. */
+typedef struct {
+    _Alignas(64) atomic_long top;
+    char pad0[64 - sizeof(atomic_long)];
+    atomic_long bottom;
+    char pad1[64 - sizeof(atomic_long)];
+    Job jobs[JOB_DEQUE_SIZE];
+} Deque;
+
+/* Live counterparts of JobWorkerStats. Only the owning worker adds, but
+ * job_stats() and job_stats_reset() run on another thread, so every
+ * access is a relaxed atomic. */
+typedef struct {
+    _Atomic uint64_t busy_ns;
+    atomic_ulong jobs;
+    atomic_ulong steals;
+} WorkerCounters;
+
+typedef struct {
+    Deque deque;
+    WorkerCounters stats;
+    pthread_t thread;
+} Worker;
+
+static struct {
+    Worker *workers;
+    int count;              /* including the main thread */
+    atomic_bool running;
+    atomic_int queued;
+    atomic_int sleepers;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    uint64_t stats_start;
+} J;
+
+/* -1 on threads the pool doesn't know about. */
+static _Thread_local int worker_id = -1;
+
+static uint64_t now_ns()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000ull + t.tv_nsec;
+}
+
+static bool deque_push(Deque *d, Job job)
+{
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= JOB_DEQUE_SIZE)
+        return false;
+
+    d->jobs[b & (JOB_DEQUE_SIZE - 1)] = job;
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+static bool deque_pop(Deque *d, Job *job)
+{
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+
+    *job = d->jobs[b & (JOB_DEQUE_SIZE - 1)];
+    if (t == b) {
+        /* Last job: race the thieves for it. */
+        bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+static bool deque_steal(Deque *d, Job *job)
+{
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (t >= b)
+        return false;
+
+    *job = d->jobs[t & (JOB_DEQUE_SIZE - 1)];
+    return atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed);
+}
+
+static void execute(Worker *w, Job *job)
+{
+    uint64_t start = now_ns();
+    job->fn(job->data);
+    atomic_fetch_add_explicit(&w->stats.busy_ns, now_ns() - start, memory_order_relaxed);
+    atomic_fetch_add_explicit(&w->stats.jobs, 1, memory_order_relaxed);
+    if (job->counter)
+        atomic_fetch_sub_explicit(&job->counter->pending, 1, memory_order_release);
+}
+
+/* Run one job from our own deque, or steal one. */
+static bool run_one(int id)
+{
+    Worker *w = &J.workers[id];
+    Job job;
+
+    if (deque_pop(&w->deque, &job)) {
+        atomic_fetch_sub(&J.queued, 1);
+        execute(w, &job);
+        return true;
+    }
+
+    for (int i = 1; i < J.count; i++) {
+        Worker *victim = &J.workers[(id + i) % J.count];
+        if (deque_steal(&victim->deque, &job)) {
+            atomic_fetch_sub(&J.queued, 1);
+            atomic_fetch_add_explicit(&w->stats.steals, 1, memory_order_relaxed);
+            execute(w, &job);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *worker_main(void *arg)
+{
+    worker_id = (int) (intptr_t) arg;
+    int idle = 0;
+
+    while (atomic_load(&J.running)) {
+        if (run_one(worker_id)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_BEFORE_SLEEP) {
+            sched_yield();
+            continue;
+        }
+
+        /* Announce ourselves before re-checking the queue; job_submit()
+         * bumps queued before reading sleepers, so one side sees the other. */
+        pthread_mutex_lock(&J.lock);
+        atomic_fetch_add(&J.sleepers, 1);
+        while (atomic_load(&J.running) && !atomic_load(&J.queued))
+            pthread_cond_wait(&J.wake, &J.lock);
+        atomic_fetch_sub(&J.sleepers, 1);
+        pthread_mutex_unlock(&J.lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+void job_init(int workers)
+{
+    if (workers == JOB_WORKERS_AUTO) {
+        const char *env = getenv("JOB_WORKERS");
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = env ? atoi(env) : (int) cores - 1;
+    }
+    if (workers < 0)
+        workers = 0;
+    if (workers > JOB_MAX_WORKERS - 1)
+        workers = JOB_MAX_WORKERS - 1;
+
+    memset(&J, 0, sizeof(J));
+    J.count = workers + 1;
+    J.workers = aligned_alloc(64, sizeof(Worker) * J.count);
+    if (!J.workers) {
+        log_fatal("job: out of memory for %d workers", workers);
+        exit(1);
+    }
+    memset(J.workers, 0, sizeof(Worker) * J.count);
+    atomic_store(&J.running, true);
+    pthread_mutex_init(&J.lock, NULL);
+    pthread_cond_init(&J.wake, NULL);
+    J.stats_start = now_ns();
+    worker_id = 0;
+
+    for (int i = 1; i < J.count; i++) {
+        if (pthread_create(&J.workers[i].thread, NULL, worker_main, (void *) (intptr_t) i)) {
+            log_error("job: failed to start worker %d, continuing with %d", i, i - 1);
+            J.count = i;
+            break;
+        }
+    }
+
+    log_info("job: %d worker threads%s", J.count - 1, J.count == 1 ? " (deterministic inline mode)" : "");
+}
+
+void job_shutdown()
+{
+    atomic_store(&J.running, false);
+    pthread_mutex_lock(&J.lock);
+    pthread_cond_broadcast(&J.wake);
+    pthread_mutex_unlock(&J.lock);
+
+    for (int i = 1; i < J.count; i++)
+        pthread_join(J.workers[i].thread, NULL);
+
+    pthread_mutex_destroy(&J.lock);
+    pthread_cond_destroy(&J.wake);
+    free(J.workers);
+    J.workers = NULL;
+    J.count = 0;
+}
+
+int job_worker_count()
+{
+    return J.count;
+}
+
+int job_worker_index()
+{
+    return worker_id;
+}
+
+void job_submit(JobFn fn, void *data, JobCounter *counter)
+{
+    Job job = {fn, data, counter};
+
+    if (counter)
+        atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+
+    /* Inline mode, foreign threads and full deques run the job right away. */
+    if (J.count <= 1 || worker_id < 0 || !deque_push(&J.workers[worker_id].deque, job)) {
+        Worker *w = &J.workers[worker_id < 0 ? 0 : worker_id];
+        job.fn(job.data);
+        if (worker_id >= 0)
+            atomic_fetch_add_explicit(&w->stats.jobs, 1, memory_order_relaxed);
+        if (counter)
+            atomic_fetch_sub_explicit(&counter->pending, 1, memory_order_release);
+        return;
+    }
+
+    atomic_fetch_add(&J.queued, 1);
+    if (atomic_load(&J.sleepers)) {
+        pthread_mutex_lock(&J.lock);
+        pthread_cond_signal(&J.wake);
+        pthread_mutex_unlock(&J.lock);
+    }
+}
+
+/* Help out with queued jobs instead of blocking. */
+void job_wait(JobCounter *counter)
+{
+    while (atomic_load_explicit(&counter->pending, memory_order_acquire) > 0) {
+        if (worker_id < 0 || !run_one(worker_id))
+            sched_yield();
+    }
+}
+
+typedef struct {
+    JobRangeFn fn;
+    void *data;
+    unsigned int begin, end;
+} RangeJob;
+
+static void run_range(void *data)
+{
+    RangeJob *r = data;
+    r->fn(r->data, r->begin, r->end);
+}
+
+void job_parallel_for(unsigned int count, unsigned int grain, JobRangeFn fn, void *data)
+{
+    if (!count)
+        return;
+    if (!grain)
+        grain = 1;
+
+    /* A few chunks per worker balances well without flooding the deques. */
+    unsigned int chunks = (count + grain - 1) / grain;
+    unsigned int max_chunks = J.count * 4;
+    if (max_chunks > PARALLEL_FOR_MAX_CHUNKS)
+        max_chunks = PARALLEL_FOR_MAX_CHUNKS;
+    if (chunks > max_chunks)
+        chunks = max_chunks;
+
+    if (chunks <= 1 || J.count <= 1) {
+        fn(data, 0, count);
+        return;
+    }
+
+    RangeJob ranges[PARALLEL_FOR_MAX_CHUNKS];
+    JobCounter counter = {0};
+    unsigned int step = count / chunks, extra = count % chunks, begin = 0;
+
+    for (unsigned int i = 0; i < chunks; i++) {
+        unsigned int end = begin + step + (i < extra);
+        ranges[i] = (RangeJob) {fn, data, begin, end};
+        begin = end;
+    }
+    /* Keep the first chunk for ourselves. */
+    for (unsigned int i = 1; i < chunks; i++)
+        job_submit(run_range, &ranges[i], &counter);
+    run_range(&ranges[0]);
+    job_wait(&counter);
+}
+
+void job_stats(JobWorkerStats *stats, uint64_t *wall_ns)
+{
+    for (int i = 0; i < J.count; i++) {
+        WorkerCounters *c = &J.workers[i].stats;
+        stats[i].busy_ns = atomic_load_explicit(&c->busy_ns, memory_order_relaxed);
+        stats[i].jobs = atomic_load_explicit(&c->jobs, memory_order_relaxed);
+        stats[i].steals = atomic_load_explicit(&c->steals, memory_order_relaxed);
+    }
+    if (wall_ns)
+        *wall_ns = now_ns() - J.stats_start;
+}
+
+void job_stats_reset()
+{
+    for (int i = 0; i < J.count; i++) {
+        WorkerCounters *c = &J.workers[i].stats;
+        atomic_store_explicit(&c->busy_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->jobs, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->steals, 0, memory_order_relaxed);
+    }
+    J.stats_start = now_ns();
+}
+
+void job_stats_log()
+{
+    JobWorkerStats stats[JOB_MAX_WORKERS];
+    uint64_t wall;
+    job_stats(stats, &wall);
+
+    for (int i = 0; i < J.count; i++) {
+        log_info("job: worker %d: %5.1f%% busy, %lu jobs, %lu steals",
+                 i, wall ? 100.0 * stats[i].busy_ns / wall : 0.0, stats[i].jobs, stats[i].steals);
+    }
+}
+
+void frame_graph_init(FrameGraph *g)
+{
+    memset(g, 0, sizeof(*g));
+}
+
+int frame_graph_add(FrameGraph *g, const char *name, JobFn fn, void *data, bool main_thread)
+{
+    if (g->count == FRAME_MAX_NODES) {
+        log_error("frame graph: too many nodes adding '%s'", name);
+        return -1;
+    }
+
+    FrameNode *n = &g->nodes[g->count];
+    memset(n, 0, sizeof(*n));
+    n->name = name;
+    n->fn = fn;
+    n->data = data;
+    n->main_thread = main_thread;
+    n->graph = g;
+    return g->count++;
+}
+
+void frame_graph_depend(FrameGraph *g, int node, int on)
+{
+    FrameNode *n = &g->nodes[node];
+    if (on >= node) {
+        log_error("frame graph: '%s' may only depend on earlier nodes", n->name);
+        return;
+    }
+    if (n->dep_count == FRAME_MAX_DEPS) {
+        log_error("frame graph: too many dependencies on '%s'", n->name);
+        return;
+    }
+    n->deps[n->dep_count++] = on;
+}
+
+static void node_ready(FrameGraph *g, int i);
+
+static void run_node(void *data)
+{
+    FrameNode *n = data;
+    FrameGraph *g = n->graph;
+    int i = n - g->nodes;
+
+    prof_begin(n->name);
+    n->fn(n->data);
+    prof_end();
+
+    for (int j = i + 1; j < g->count; j++) {
+        for (int d = 0; d < g->nodes[j].dep_count; d++) {
+            if (g->nodes[j].deps[d] == i && atomic_fetch_sub(&g->nodes[j].remaining, 1) == 1)
+                node_ready(g, j);
+        }
+    }
+    atomic_fetch_sub(&g->unfinished, 1);
+}
+
+static void node_ready(FrameGraph *g, int i)
+{
+    if (g->nodes[i].main_thread)
+        atomic_fetch_or(&g->main_ready, 1ull << i);
+    else
+        job_submit(run_node, &g->nodes[i], &g->counter);
+}
+
+/* Run every node once, respecting dependencies. The caller executes the
+ * main-thread nodes and helps with worker nodes in between. */
+void frame_graph_run(FrameGraph *g)
+{
+    atomic_store(&g->unfinished, g->count);
+    atomic_store(&g->main_ready, 0);
+    for (int i = 0; i < g->count; i++)
+        atomic_store(&g->nodes[i].remaining, g->nodes[i].dep_count);
+
+    for (int i = 0; i < g->count; i++)
+        if (!g->nodes[i].dep_count)
+            node_ready(g, i);
+
+    while (atomic_load(&g->unfinished) > 0) {
+        uint64_t ready = atomic_exchange(&g->main_ready, 0);
+        if (ready) {
+            for (int i = 0; i < g->count; i++)
+                if (ready & (1ull << i))
+                    run_node(&g->nodes[i]);
+            continue;
+        }
+        if (worker_id < 0 || !run_one(worker_id))
+            sched_yield();
+    }
+    job_wait(&g->counter);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOB_MAX_WORKERS 64
+#define JOB_DEQUE_SIZE 4096     /* power of two */
+#define FRAME_MAX_NODES 32
+#define FRAME_MAX_DEPS 8
+#define JOB_WORKERS_AUTO -1     /* $JOB_WORKERS if set, else one per extra core */
+
+typedef void (*JobFn)(void *data);
+typedef void (*JobRangeFn)(void *data, unsigned int begin, unsigned int end);
+
+/* Number of unfinished jobs; job_wait() returns once it drops to zero. */
+typedef struct {
+    atomic_int pending;
+} JobCounter;
+
+typedef struct {
+    JobFn fn;
+    void *data;
+    JobCounter *counter;
+} Job;
+
+typedef struct {
+    uint64_t busy_ns;
+    unsigned long jobs;
+    unsigned long steals;
+} JobWorkerStats;
+
+typedef struct FrameGraph FrameGraph;
+
+typedef struct {
+    const char *name;
+    JobFn fn;
+    void *data;
+    bool main_thread;   /* run on the thread calling frame_graph_run(), e.g. for GL calls */
+    int deps[FRAME_MAX_DEPS];
+    int dep_count;
+    atomic_int remaining;
+    FrameGraph *graph;
+} FrameNode;
+
+/* A DAG of per-frame tasks. Worker nodes are submitted as jobs as soon as
+ * their dependencies finish; main-thread nodes are flagged in main_ready and
+ * picked up by the thread inside frame_graph_run(). */
+struct FrameGraph {
+    FrameNode nodes[FRAME_MAX_NODES];
+    int count;
+    atomic_uint_least64_t main_ready;
+    atomic_int unfinished;
+    JobCounter counter;
+};
+
+/* workers counts the threads besides the caller, which becomes worker 0.
+ * With 0 workers every job runs inline at submission, in order. */
+void job_init(int workers);
+void job_shutdown(void);
+int job_worker_count(void);
+int job_worker_index(void);
+void job_submit(JobFn fn, void *data, JobCounter *counter);
+void job_wait(JobCounter *counter);
+void job_parallel_for(unsigned int count, unsigned int grain, JobRangeFn fn, void *data);
+void job_stats(JobWorkerStats *stats, uint64_t *wall_ns);
+void job_stats_log(void);
+void job_stats_reset(void);
+
+void frame_graph_init(FrameGraph *g);
+int frame_graph_add(FrameGraph *g, const char *name, JobFn fn, void *data, bool main_thread);
+void frame_graph_depend(FrameGraph *g, int node, int on);
+void frame_graph_run(FrameGraph *g);
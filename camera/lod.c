@@ -0,0 +1,390 @@
+#include "lod.h"
+#include "log.h"
+#include "resource.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#define LOD_BORDER_WEIGHT 10.0
+
+/* Plane quadric (Garland & Heckbert) kept as the upper triangle of a
+ * symmetric 4x4 matrix, plus the total area weight that went into it. */
+typedef struct {
+    double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+    double w;
+} Quadric;
+
+typedef struct {
+    uint64_t key; /* min vertex in the high word, max vertex in the low word */
+    unsigned int tri;
+} Edge;
+
+typedef struct {
+    unsigned int from, to;
+    double cost;
+} Collapse;
+
+static void quadric_add_plane(Quadric *q, double a, double b, double c, double d, double w)
+{
+    q->a2 += a * a * w; q->ab += a * b * w; q->ac += a * c * w; q->ad += a * d * w;
+    q->b2 += b * b * w; q->bc += b * c * w; q->bd += b * d * w;
+    q->c2 += c * c * w; q->cd += c * d * w;
+    q->d2 += d * d * w;
+    q->w += w;
+}
+
+static void quadric_add(Quadric *dst, const Quadric *q)
+{
+    dst->a2 += q->a2; dst->ab += q->ab; dst->ac += q->ac; dst->ad += q->ad;
+    dst->b2 += q->b2; dst->bc += q->bc; dst->bd += q->bd;
+    dst->c2 += q->c2; dst->cd += q->cd;
+    dst->d2 += q->d2;
+    dst->w += q->w;
+}
+
+/* Mean squared distance of p to the planes accumulated in q. */
+static double quadric_error(const Quadric *q, const GLfloat *p)
+{
+    double x = p[0], y = p[1], z = p[2];
+    double e = q->a2 * x * x + 2 * q->ab * x * y + 2 * q->ac * x * z + 2 * q->ad * x
+             + q->b2 * y * y + 2 * q->bc * y * z + 2 * q->bd * y
+             + q->c2 * z * z + 2 * q->cd * z
+             + q->d2;
+    return q->w > 0.0 ? fabs(e) / q->w : 0.0;
+}
+
+static int edge_cmp(const void *a, const void *b)
+{
+    uint64_t ka = ((const Edge *)a)->key, kb = ((const Edge *)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+static int collapse_cmp(const void *a, const void *b)
+{
+    double ca = ((const Collapse *)a)->cost, cb = ((const Collapse *)b)->cost;
+    return (ca > cb) - (ca < cb);
+}
+
+static unsigned int collect_edges(Edge *edges, const unsigned int *indices, unsigned int len_indices)
+{
+    unsigned int n = 0;
+    for (unsigned int t = 0; t < len_indices; t += 3) {
+        for (int k = 0; k < 3; k++) {
+            uint64_t a = indices[t + k], b = indices[t + (k + 1) % 3];
+            edges[n++] = (Edge) {a < b ? (a << 32) | b : (b << 32) | a, t};
+        }
+    }
+    qsort(edges, n, sizeof(*edges), edge_cmp);
+    return n;
+}
+
+static void triangle_normal(const GLfloat *vertices, const unsigned int *tri, double n[3], double *area)
+{
+    const GLfloat *p0 = &vertices[3 * tri[0]], *p1 = &vertices[3 * tri[1]], *p2 = &vertices[3 * tri[2]];
+    double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    double len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    *area = len * 0.5;
+    if (len > 0.0) {
+        n[0] /= len; n[1] /= len; n[2] /= len;
+    }
+}
+
+static void init_quadrics(Quadric *quadrics, Edge *edges, const unsigned int *indices, unsigned int len_indices, const GLfloat *vertices)
+{
+    for (unsigned int t = 0; t < len_indices; t += 3) {
+        double n[3], area;
+        triangle_normal(vertices, &indices[t], n, &area);
+        const GLfloat *p0 = &vertices[3 * indices[t]];
+        double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+        for (int k = 0; k < 3; k++)
+            quadric_add_plane(&quadrics[indices[t + k]], n[0], n[1], n[2], d, area);
+    }
+
+    /* Open borders get a plane perpendicular to their face so they don't shrink inwards. */
+    unsigned int count = collect_edges(edges, indices, len_indices);
+    for (unsigned int i = 0, j; i < count; i = j) {
+        for (j = i + 1; j < count && edges[j].key == edges[i].key; j++);
+        if (j - i != 1)
+            continue;
+
+        unsigned int a = edges[i].key >> 32, b = edges[i].key & 0xffffffff;
+        const GLfloat *pa = &vertices[3 * a], *pb = &vertices[3 * b];
+        double n[3], area;
+        triangle_normal(vertices, &indices[edges[i].tri], n, &area);
+        double e[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+        double p[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0]};
+        double len = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len == 0.0)
+            continue;
+        p[0] /= len; p[1] /= len; p[2] /= len;
+        double d = -(p[0] * pa[0] + p[1] * pa[1] + p[2] * pa[2]);
+        double w = LOD_BORDER_WEIGHT * len * len;
+        quadric_add_plane(&quadrics[a], p[0], p[1], p[2], d, w);
+        quadric_add_plane(&quadrics[b], p[0], p[1], p[2], d, w);
+    }
+}
+
+/* Quadric-error-metric simplification by half-edge collapse: vertices are
+ * only ever merged onto existing vertices, so every level can index the
+ * original vertex buffer. Returns the index count written to dst, which must
+ * have room for len_indices entries. */
+unsigned int lod_simplify(unsigned int *dst, const unsigned int *indices, unsigned int len_indices,
+                          const GLfloat *vertices, unsigned int len_vertices,
+                          unsigned int target_len, float *out_error)
+{
+    unsigned int vcount = len_vertices / 3;
+    Quadric *quadrics = calloc(vcount, sizeof(*quadrics));
+    unsigned int *remap = malloc(sizeof(*remap) * vcount);
+    unsigned char *locked = malloc(vcount);
+    Edge *edges = malloc(sizeof(*edges) * len_indices);
+    Collapse *collapses = malloc(sizeof(*collapses) * len_indices);
+    unsigned int count = len_indices;
+    double max_error = 0.0;
+
+    if (!quadrics || !remap || !locked || !edges || !collapses) {
+        log_error("lod: out of memory simplifying %u indices", len_indices);
+        count = 0;
+        goto end;
+    }
+
+    memcpy(dst, indices, sizeof(*dst) * len_indices);
+    init_quadrics(quadrics, edges, dst, count, vertices);
+
+    while (count > target_len) {
+        unsigned int nedges = collect_edges(edges, dst, count);
+        unsigned int ncollapses = 0;
+        for (unsigned int i = 0, j; i < nedges; i = j) {
+            for (j = i + 1; j < nedges && edges[j].key == edges[i].key; j++);
+            unsigned int a = edges[i].key >> 32, b = edges[i].key & 0xffffffff;
+            Quadric q = quadrics[a];
+            quadric_add(&q, &quadrics[b]);
+            double a_to_b = quadric_error(&q, &vertices[3 * b]);
+            double b_to_a = quadric_error(&q, &vertices[3 * a]);
+            collapses[ncollapses++] = a_to_b <= b_to_a ? (Collapse) {a, b, a_to_b} : (Collapse) {b, a, b_to_a};
+        }
+        qsort(collapses, ncollapses, sizeof(*collapses), collapse_cmp);
+
+        for (unsigned int v = 0; v < vcount; v++) {
+            remap[v] = v;
+            locked[v] = 0;
+        }
+
+        /* Cheapest collapses first, each vertex touched at most once per pass.
+         * An interior collapse removes two triangles. */
+        unsigned int budget = (count - target_len) / 3, removed = 0;
+        for (unsigned int i = 0; i < ncollapses && removed < budget; i++) {
+            Collapse *c = &collapses[i];
+            if (locked[c->from] || locked[c->to])
+                continue;
+            remap[c->from] = c->to;
+            locked[c->from] = locked[c->to] = 1;
+            quadric_add(&quadrics[c->to], &quadrics[c->from]);
+            if (c->cost > max_error)
+                max_error = c->cost;
+            removed += 2;
+        }
+
+        unsigned int out = 0;
+        for (unsigned int t = 0; t < count; t += 3) {
+            unsigned int a = remap[dst[t]], b = remap[dst[t + 1]], c = remap[dst[t + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+            dst[out++] = a;
+            dst[out++] = b;
+            dst[out++] = c;
+        }
+
+        if (out == count)
+            break;
+        count = out;
+    }
+
+end:
+    if (out_error)
+        *out_error = (float) sqrt(max_error);
+    free(quadrics);
+    free(remap);
+    free(locked);
+    free(edges);
+    free(collapses);
+    return count;
+}
+
+void lod_create_mesh(LodMesh *m, GLfloat *vertices, unsigned int *indices, unsigned int len_vertices, unsigned int len_indices)
+{
+    /* Every level is at most as large as level 0. */
+    unsigned int *chain = malloc(sizeof(*chain) * len_indices * LOD_MAX_LEVELS);
+    unsigned int total = len_indices;
+    if (!chain) {
+        log_fatal("lod: out of memory for %u indices", len_indices * LOD_MAX_LEVELS);
+        exit(1);
+    }
+
+    memset(m, 0, sizeof(*m));
+    memcpy(chain, indices, sizeof(*chain) * len_indices);
+    m->levels[0] = (LodLevel) {0, len_indices, 0.0f};
+    m->level_count = 1;
+
+    while (m->level_count < LOD_MAX_LEVELS) {
+        const LodLevel *prev = &m->levels[m->level_count - 1];
+        unsigned int target = prev->index_count / 6 * 3;
+        if (target < 3)
+            break;
+
+        float error;
+        unsigned int n = lod_simplify(chain + total, chain + prev->index_offset, prev->index_count,
+                                      vertices, len_vertices, target, &error);
+        /* Stop once simplification stalls, a near-duplicate level only costs memory. */
+        if (!n || n > prev->index_count / 4 * 3)
+            break;
+
+        /* Each level is built from the previous one, so errors accumulate. */
+        m->levels[m->level_count] = (LodLevel) {total, n, prev->error + error};
+        m->level_count++;
+        total += n;
+    }
+
+    vec3 lo = {vertices[0], vertices[1], vertices[2]}, hi = {vertices[0], vertices[1], vertices[2]};
+    for (unsigned int i = 3; i + 2 < len_vertices; i += 3) {
+        glm_vec3_minv(lo, &vertices[i], lo);
+        glm_vec3_maxv(hi, &vertices[i], hi);
+    }
+    glm_vec3_lerp(lo, hi, 0.5f, m->center);
+    for (unsigned int i = 0; i + 2 < len_vertices; i += 3) {
+        float d = glm_vec3_distance(m->center, &vertices[i]);
+        if (d > m->radius)
+            m->radius = d;
+    }
+
+    m->vertices = malloc(sizeof(*vertices) * len_vertices);
+    m->indices = realloc(chain, sizeof(*chain) * total);
+    if (!m->vertices || !m->indices) {
+        log_fatal("lod: out of memory keeping a mesh in system memory");
+        exit(1);
+    }
+    memcpy(m->vertices, vertices, sizeof(*vertices) * len_vertices);
+    m->vertex_count = len_vertices;
+    m->index_count = total;
+    lod_restore(m);
+
+    for (int i = 0; i < m->level_count; i++)
+        log_debug("lod: level %d: %u triangles, error %f", i, m->levels[i].index_count / 3, m->levels[i].error);
+}
+
+void lod_clear_mesh(LodMesh *m)
+{
+    gpumem_stream_remove(&m->stream);
+    clear_mesh(m->mesh);
+    free(m->vertices);
+    free(m->indices);
+    m->vertices = NULL;
+    m->indices = NULL;
+    m->level_count = 0;
+}
+
+/* Buffers another mesh also holds stay allocated after clear_mesh(), so a
+ * mesh owning none of its own is left resident instead of being dropped
+ * and uploaded again for nothing. */
+static size_t evict(GpuStream *s)
+{
+    LodMesh *m = (LodMesh *) ((char *) s - offsetof(LodMesh, stream));
+    size_t bytes = resource_buffer_exclusive(m->mesh[VBO]) + resource_buffer_exclusive(m->mesh[IBO]);
+    if (bytes)
+        clear_mesh(m->mesh);
+    return bytes;
+}
+
+bool lod_resident(const LodMesh *m)
+{
+    return m->mesh[VAO] != 0;
+}
+
+/* Uploads the mesh again after an eviction. The VAO is new, so per-VAO
+ * state such as mesh_set_instance() has to be set up again. */
+void lod_restore(LodMesh *m)
+{
+    create_mesh(m->mesh, m->vertices, m->indices, m->vertex_count, m->index_count);
+    gpumem_stream_add(&m->stream, evict);
+}
+
+/* Pixels covered by one world unit at distance 1 along the view axis. */
+float lod_projection_scale(mat4 projection, int viewport_height)
+{
+    return projection[1][1] * 0.5f * viewport_height;
+}
+
+int lod_select(const LodMesh *m, int current, float distance, float scale, float proj_scale)
+{
+    float px = scale * proj_scale / fmaxf(distance, 1e-3f);
+    int target = 0;
+
+    if (current >= m->level_count)
+        current = m->level_count - 1;
+
+    for (int i = m->level_count - 1; i > 0; i--) {
+        if (m->levels[i].error * px <= LOD_ERROR_PIXELS) {
+            target = i;
+            break;
+        }
+    }
+
+    /* Refine as soon as the budget is exceeded, but only coarsen once the
+     * level is comfortably under it, so objects near a threshold don't pop. */
+    while (target > current && m->levels[target].error * px > LOD_ERROR_PIXELS * LOD_HYSTERESIS)
+        target--;
+
+    return target;
+}
+
+void lod_record(CmdBuffer *b, GLuint program, const LodMesh *m, int level, LodStats *stats)
+{
+    const LodLevel *l = &m->levels[level];
+
+    cmd_begin(b, CMD_KEY(program, m->mesh[VAO], 0));
+    cmd_use_program(b, program);
+    cmd_bind_mesh(b, m->mesh[VAO]);
+    cmd_draw_elements(b, l->index_count, sizeof(GLuint) * l->index_offset);
+    cmd_end(b);
+
+    if (stats) {
+        stats->triangles += l->index_count / 3;
+        stats->full_triangles += m->levels[0].index_count / 3;
+        stats->draws++;
+        stats->per_level[level]++;
+    }
+}
+
+void lod_stats_reset(LodStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void lod_stats_add(LodStats *dst, const LodStats *src)
+{
+    dst->triangles += src->triangles;
+    dst->full_triangles += src->full_triangles;
+    dst->draws += src->draws;
+    dst->culled += src->culled;
+    for (int i = 0; i < LOD_MAX_LEVELS; i++)
+        dst->per_level[i] += src->per_level[i];
+}
+
+void lod_stats_log(const LodStats *stats)
+{
+    char levels[LOD_MAX_LEVELS * 12] = "";
+    int len = 0;
+
+    for (int i = 0; i < LOD_MAX_LEVELS; i++)
+        len += snprintf(levels + len, sizeof(levels) - len, " %u", stats->per_level[i]);
+
+    log_info("lod: %lu/%lu triangles submitted (%.1f%%) in %u draws, %u culled, draws per level:%s",
+             stats->triangles, stats->full_triangles,
+             stats->full_triangles ? 100.0 * stats->triangles / stats->full_triangles : 0.0,
+             stats->draws, stats->culled, levels);
+}
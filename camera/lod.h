@@ -0,0 +1,54 @@
+#pragma once
+#include "gl_loader.h"
+#include <cglm/cglm.h>
+#include "mesh.h"
+#include "cmdbuf.h"
+#include "gpumem.h"
+
+#define LOD_MAX_LEVELS 6
+#define LOD_ERROR_PIXELS 1.0f   /* screen-space error budget per object */
+#define LOD_HYSTERESIS 0.75f    /* coarsening needs the error this far under budget */
+
+typedef struct {
+    unsigned int index_offset; /* first index of the level inside the shared IBO */
+    unsigned int index_count;
+    float error;               /* object-space geometric error of the level */
+} LodLevel;
+
+/* All levels share one VBO and live back to back in one IBO, level 0 first.
+ * The vertices and indices stay in system memory, so the GPU copy can be
+ * evicted under a memory budget and restored the next time it is drawn. */
+typedef struct {
+    GLuint mesh[4];             /* VAO 0 while evicted */
+    LodLevel levels[LOD_MAX_LEVELS];
+    int level_count;
+    vec3 center;
+    float radius;
+
+    GLfloat *vertices;
+    unsigned int *indices;
+    unsigned int vertex_count, index_count;
+    GpuStream stream;
+} LodMesh;
+
+typedef struct {
+    unsigned long triangles;
+    unsigned long full_triangles;
+    unsigned int draws;
+    unsigned int culled;
+    unsigned int per_level[LOD_MAX_LEVELS];
+} LodStats;
+
+unsigned int lod_simplify(unsigned int *dst, const unsigned int *indices, unsigned int len_indices,
+                          const GLfloat *vertices, unsigned int len_vertices,
+                          unsigned int target_len, float *out_error);
+void lod_create_mesh(LodMesh *m, GLfloat *vertices, unsigned int *indices, unsigned int len_vertices, unsigned int len_indices);
+void lod_clear_mesh(LodMesh *m);
+bool lod_resident(const LodMesh *m);
+void lod_restore(LodMesh *m);
+float lod_projection_scale(mat4 projection, int viewport_height);
+int lod_select(const LodMesh *m, int current, float distance, float scale, float proj_scale);
+void lod_record(CmdBuffer *b, GLuint program, const LodMesh *m, int level, LodStats *stats);
+void lod_stats_reset(LodStats *stats);
+void lod_stats_add(LodStats *dst, const LodStats *src);
+void lod_stats_log(const LodStats *stats);
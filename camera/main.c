@@ -1,21 +1,38 @@
 #include "gl_shader.h"
 #include "window.h"
 #include "camera.h"
+#include "mesh.h"
+#include "lod.h"
+#include "scene.h"
+#include "ecs.h"
+#include "job.h"
+#include "cmdbuf.h"
+#include "timestep.h"
+#include "startup.h"
+#include "triple.h"
+#include "pacing.h"
+#include "profile.h"
+#include "gl_debug.h"
+#include "campath.h"
+#include "metrics.h"
+#include "gpumem.h"
+#include "resource.h"
+#include "stream.h"
+#include <pthread.h>
+#include <string.h>
 
-#define VEC3_SUM(v1, v2) (vec3) {v1[0] + v2[0], v1[1] + v2[1], v1[2] + v2[2]}
 #define VEC3(x, y, z) (vec3) {x, y, z}
-#define P_GLUMAT(m) (&m[0][0])
+#define UNIFORM_CAMERA 0            /* uniform buffer binding of the Camera block */
 
-static GLuint mesh_arr[2][4];
-GLfloat last_time = 0.0f;
-GLfloat delta_time = 0.0f;
+#define RENDERABLE (COMP_BIT(COMP_TRANSFORM) | COMP_BIT(COMP_MESH) | COMP_BIT(COMP_BOUNDS) | COMP_BIT(COMP_MATERIAL))
 
-enum {
-    VAO,
-    VBO,
-    IBO,
-    INDEX_COUNT
-};
+static LodMesh mesh_arr[2];
+static LodStats lod_stats[JOB_MAX_WORKERS];
+static CmdQueue queue;
+static Scene scene;
+static EcsWorld world;
+static GLuint instance_buffer;
+static StreamBuffer stream;
 
 const char *frag_s = GLSL(330,
     in vec4 vcol;
@@ -28,12 +45,14 @@ const char *frag_s = GLSL(330,
 
 const char *vert_s = GLSL(330,
     layout (location = 0) in vec3 pos;
+    layout (location = 1) in mat4 model;
 
     out vec4 vcol;
 
-    uniform mat4 model;
-    uniform mat4 projection;
-    uniform mat4 view;
+    layout (std140) uniform Camera {
+        mat4 projection;
+        mat4 view;
+    };
 
     void main() {
         gl_Position = projection * view * model * vec4(pos, 1.0);
@@ -41,140 +60,509 @@ const char *vert_s = GLSL(330,
     }
 );
 
-void create_mesh(GLuint mesh[4], GLfloat *vertices, unsigned int *indices, unsigned int len_vertices, unsigned int len_indices)
+void create_objects(GLuint prog)
 {
-    mesh[INDEX_COUNT] = len_indices;
-    glGenVertexArrays(1, &mesh[VAO]);
-    glBindVertexArray(mesh[VAO]);
+    unsigned int inds[] = {
+        0, 3, 1,
+        1, 3, 2,
+        2, 3, 0,
+        0, 1, 2
+    };
 
-    glGenBuffers(1, &mesh[IBO]);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh[IBO]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * len_indices, indices, GL_STATIC_DRAW);
+    GLfloat verts[] = {
+    	-1.0f, -1.0f, 0.0f,
+		0.0f, -1.0f, 1.0f,
+		1.0f, -1.0f, 0.0f,
+		0.0f, 1.0f, 0.0f
+    };
 
-    glGenBuffers(1, &mesh[VBO]);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh[VBO]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices[0]) * len_vertices, vertices, GL_STATIC_DRAW);
+    lod_create_mesh(&mesh_arr[0], verts, inds, 12, 12);
+    lod_create_mesh(&mesh_arr[1], verts, inds, 12, 12);
+
+    versor rot;
+    glm_quat_identity(rot);
+    scene_init(&scene, 16);
+    ecs_init(&world);
+    glGenBuffers(1, &instance_buffer);
+
+    for (int i = 0; i < 2; i++) {
+        Entity e = ecs_create(&world, RENDERABLE);
+        Transform *t = ecs_get(&world, e, COMP_TRANSFORM);
+        MeshRef *m = ecs_get(&world, e, COMP_MESH);
+        Material *mat = ecs_get(&world, e, COMP_MATERIAL);
+
+        t->node = scene_add(&scene, SCENE_NO_PARENT, VEC3(0.0f, (float) i, -2.5f), rot, VEC3(0.4f, 0.4f, 1.0f));
+        m->mesh = &mesh_arr[i];
+        mat->program = prog;
+        mesh_set_instance(m->mesh->mesh, instance_buffer, t->node);
+    }
+}
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-    glEnableVertexAttribArray(0);
+static void update_bounds(EcsView *v, void *udata)
+{
+    (void) udata;
+    Transform *t = ECS_COLUMN(*v, Transform, COMP_TRANSFORM);
+    MeshRef *m = ECS_COLUMN(*v, MeshRef, COMP_MESH);
+    Bounds *b = ECS_COLUMN(*v, Bounds, COMP_BOUNDS);
+
+    for (unsigned int i = 0; i < v->count; i++) {
+        vec4 *world = scene.world[t[i].node];
+        glm_mat4_mulv3(world, m[i].mesh->center, 1.0f, b[i].center);
+        /* World scale, parents included: the lengths of the basis columns. */
+        vec3 scale = {glm_vec3_norm(world[0]), glm_vec3_norm(world[1]), glm_vec3_norm(world[2])};
+        b[i].radius = m[i].mesh->radius * glm_vec3_max(scale);
+    }
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+typedef struct {
+    Camera *camera;
+    float proj_scale;
+} LodParams;
 
-    glBindVertexArray(0);
+static void select_lods(EcsView *v, void *udata)
+{
+    LodParams *p = udata;
+    MeshRef *m = ECS_COLUMN(*v, MeshRef, COMP_MESH);
+    Bounds *b = ECS_COLUMN(*v, Bounds, COMP_BOUNDS);
+
+    for (unsigned int i = 0; i < v->count; i++) {
+        m[i].culled = !camera_sphere_visible(p->camera, b[i].center, b[i].radius);
+        if (m[i].culled)
+            continue;
+        float distance = glm_vec3_distance(p->camera->pos, b[i].center) - b[i].radius;
+        float scale = b[i].radius / m[i].mesh->radius;
+        m[i].lod = lod_select(m[i].mesh, m[i].lod, distance, scale, p->proj_scale);
+    }
 }
 
-void render_mesh(GLuint mesh[4])
+typedef struct {
+    void (*fn)(EcsView *, void *);
+    void *udata;
+    EcsView *views;
+} ViewJob;
+
+static void run_views(void *data, unsigned int begin, unsigned int end)
 {
-    glBindVertexArray(mesh[VAO]);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh[IBO]);
-    glDrawElements(GL_TRIANGLES, mesh[INDEX_COUNT], GL_UNSIGNED_INT, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    ViewJob *job = data;
+    for (unsigned int i = begin; i < end; i++)
+        job->fn(&job->views[i], job->udata);
 }
 
-void clear_mesh(GLuint mesh[4])
+/* ecs_each() with the matching chunks spread over the job workers. */
+static void parallel_each(unsigned int mask, void (*fn)(EcsView *, void *), void *udata)
 {
-    if (mesh[IBO]) {
-        glDeleteBuffers(1, &mesh[IBO]);
-        mesh[IBO] = 0;
-    }
+    unsigned int count = ecs_query(&world, mask, NULL, 0);
+    if (!count)
+        return;
+
+    EcsView views[count];
+    ecs_query(&world, mask, views, count);
+    ViewJob job = {fn, udata, views};
+    job_parallel_for(count, 1, run_views, &job);
+}
 
-    if (mesh[VBO]) {
-        glDeleteBuffers(1, &mesh[VBO]);
-        mesh[VBO] = 0;
+/* Runs on any worker; each records into its own command buffer. */
+static void record_objects(EcsView *v, void *udata)
+{
+    (void) udata;
+    CmdBuffer *b = cmd_thread_buffer(&queue);
+    LodStats *stats = &lod_stats[job_worker_index()];
+    MeshRef *m = ECS_COLUMN(*v, MeshRef, COMP_MESH);
+    Material *mat = ECS_COLUMN(*v, Material, COMP_MATERIAL);
+
+    for (unsigned int i = 0; i < v->count; i++) {
+        if (m[i].culled)
+            stats->culled++;
+        else
+            lod_record(b, mat[i].program, m[i].mesh, m[i].lod, stats);
     }
+}
 
-    if (mesh[VAO]) {
-        glDeleteVertexArrays(1, &mesh[VAO]);
-        mesh[VAO] = 0;
-    }
+static struct {
+    LodParams lod;
+    bool camera_changed;
+} frame;
 
-    mesh[INDEX_COUNT] = 0;
+static void transform_task(void *data)
+{
+    (void) data;
+    scene_update(&scene);
 }
 
-void create_objects()
+/* Bounds only follow world matrices, and culling plus LOD selection only
+ * follow bounds and the camera, so a static frame skips both. */
+static void bounds_task(void *data)
 {
-    unsigned int inds[] = {
-        0, 3, 1,
-        1, 3, 2,
-        2, 3, 0,
-        0, 1, 2
-    };
-
-    GLfloat verts[] = {
-    	-1.0f, -1.0f, 0.0f,
-		0.0f, -1.0f, 1.0f,
-		1.0f, -1.0f, 0.0f,
-		0.0f, 1.0f, 0.0f
-    };
+    (void) data;
+    if (!scene.changed_count)
+        return;
+    parallel_each(RENDERABLE, update_bounds, NULL);
+}
 
-    create_mesh(mesh_arr[0], verts, inds, 12, 12);
-    create_mesh(mesh_arr[1], verts, inds, 12, 12);
+static void lod_task(void *data)
+{
+    (void) data;
+    if (!scene.changed_count && !frame.camera_changed)
+        return;
+    parallel_each(RENDERABLE, select_lods, &frame.lod);
 }
 
+/* Brings meshes evicted under the memory budget back before anything
+ * records a draw of them, and marks every visible mesh used so the budget
+ * evicts what's off screen first. */
+static void stream_meshes(EcsView *v, void *udata)
+{
+    (void) udata;
+    Transform *t = ECS_COLUMN(*v, Transform, COMP_TRANSFORM);
+    MeshRef *m = ECS_COLUMN(*v, MeshRef, COMP_MESH);
+
+    for (unsigned int i = 0; i < v->count; i++) {
+        if (m[i].culled)
+            continue;
+        if (!lod_resident(m[i].mesh)) {
+            lod_restore(m[i].mesh);
+            mesh_set_instance(m[i].mesh->mesh, instance_buffer, t[i].node);
+        }
+        gpumem_touch(&m[i].mesh->stream);
+    }
+}
 
-int main ()
+static void stream_task(void *data)
 {
-    struct Window *window = init_window();
+    (void) data;
+    ecs_each(&world, RENDERABLE, stream_meshes, NULL);
+}
 
-    Camera c = init_camera(VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 1.0f, 1.0f), -90.0f, 0.0f, 5.0f, 0.01f);
-    GLuint uniform_projection = 0, uniform_model = 0, uniform_view = 0;
-    mat4 projection;
+static void upload_task(void *data)
+{
+    (void) data;
+    prof_gpu_begin("upload");
+    scene_upload(&scene, instance_buffer, &stream);
+    prof_gpu_end();
+}
 
-    create_objects();
-    GLuint prog = gl_create_program_from_str(vert_s, frag_s);
+static void record_task(void *data)
+{
+    (void) data;
+    parallel_each(RENDERABLE, record_objects, NULL);
+}
 
-    glm_perspective(
-        glm_rad(45.0f),
-        16.0f / 9.0f,
-        0.1f,
-        100.0f,
-        projection
-    );
+static void submit_task(void *data)
+{
+    (void) data;
+    prof_gpu_begin("submit");
+    cmd_queue_submit(&queue);
+    prof_gpu_end();
+}
 
-    while (!glfwWindowShouldClose(window->win)) {
-        GLfloat now = glfwGetTime();
-        delta_time = now - last_time; last_time = now;
+/* Transform, bounds, LOD and draw recording run on the workers; anything
+ * touching GL stays on the main thread, which owns the context. */
+static void build_frame_graph(FrameGraph *g)
+{
+    frame_graph_init(g);
+    int transform = frame_graph_add(g, "transform", transform_task, NULL, false);
+    int bounds = frame_graph_add(g, "bounds", bounds_task, NULL, false);
+    int lod = frame_graph_add(g, "lod", lod_task, NULL, false);
+    int stream = frame_graph_add(g, "stream", stream_task, NULL, true);
+    int upload = frame_graph_add(g, "upload", upload_task, NULL, true);
+    int record = frame_graph_add(g, "record", record_task, NULL, false);
+    int submit = frame_graph_add(g, "submit", submit_task, NULL, true);
+
+    frame_graph_depend(g, bounds, transform);
+    frame_graph_depend(g, lod, bounds);
+    frame_graph_depend(g, upload, transform);
+    frame_graph_depend(g, stream, lod);
+    frame_graph_depend(g, record, stream);
+    frame_graph_depend(g, submit, record);
+    frame_graph_depend(g, submit, upload);
+}
 
-        glfwPollEvents();
+/* Everything the render thread needs from the simulation for one frame. */
+typedef struct {
+    Camera camera;              /* refreshed: matrices and frustum are valid */
+    int width, height;          /* framebuffer size */
+    unsigned long tick;
+    double input_time;          /* newest input event folded into this state */
+} RenderSnapshot;
+
+static RenderSnapshot snapshots[3];
+static TripleBuffer snapshot_buffer;
+static Redraw redraw;
+static atomic_bool running = true;
+static CamPath path;
+static bool playing;            /* the render thread follows path, not the snapshots */
+
+/* Busy and waiting time of one thread's loop, logged about once a second. */
+typedef struct {
+    const char *name;
+    double busy, wait, since;
+    unsigned long loops;
+} ThreadTiming;
+
+static void thread_timing_add(ThreadTiming *t, double busy, double wait, double now)
+{
+    t->busy += busy;
+    t->wait += wait;
+    t->loops++;
+    if (now - t->since < 1.0)
+        return;
+    log_info("thread %s: %lu loops/s, %.3f ms busy + %.3f ms waiting per loop", t->name,
+             t->loops, t->busy * 1e3 / t->loops, t->wait * 1e3 / t->loops);
+    t->busy = t->wait = 0.0;
+    t->loops = 0;
+    t->since = now;
+}
 
-        c.key_control(&c, window->keys, delta_time);
-        c.mouse_control(&c, window->x_change, window->y_change);
+/* Owns the GL context, the job system and all render state; consumes the
+ * newest snapshot each frame, so simulating frame N+1 on the main thread
+ * overlaps submitting frame N here. */
+static void *render_thread(void *arg)
+{
+    struct Window *window = arg;
+    window_make_current(window);
+
+    FrameGraph graph;
+    prof_init();
+    job_init(JOB_WORKERS_AUTO);
+    build_frame_graph(&graph);
+    startup_phase("job system");
+
+    GLuint prog = resource_program(vert_s, frag_s);
+    gl_uniform_block_binding(prog, "Camera", UNIFORM_CAMERA);
+    startup_phase("shaders");
+    create_objects(prog);
+    cmd_queue_init(&queue);
+    stream_init(&stream, 0);
+    startup_phase("mesh upload");
+
+    const char *interval = getenv("SWAP_INTERVAL");
+    window_set_swap_interval(window, interval ? atoi(interval) : 1);
+    FramePacer pacer;
+    pacing_init(&pacer, 0, -1.0);
+
+    Camera c = {0};
+    Camera play = snapshots[triple_read_slot(&snapshot_buffer)].camera;
+    int width = 0, height = 0;
+    ThreadTiming timing = {.name = "render", .since = window_time()};
+    double last_report = timing.since, last_swap = 0.0;
+    LodStats total;
+
+    while (atomic_load(&running)) {
+        /* On demand, sleep until the simulation or window reports damage. */
+        if (!(redraw_wait(&redraw) & DAMAGE_ALL))
+            continue;
+        if (playing && !campath_next(&path, &play)) {
+            atomic_store(&running, false);
+            break;
+        }
+
+        /* Wait for the GPU and the limiter first, then take the newest
+         * snapshot, so the frame carries the latest input. */
+        double paced = window_time();
+        pacing_begin_frame(&pacer);
+        stream_begin_frame(&stream);
+        double start = window_time();
+        prof_frame_begin();
+        prof_begin("frame");
+        prof_gpu_begin("frame");
+        triple_acquire(&snapshot_buffer);
+        const RenderSnapshot *snap = &snapshots[triple_read_slot(&snapshot_buffer)];
+
+        for (int i = 0; i < JOB_MAX_WORKERS; i++)
+            lod_stats_reset(&lod_stats[i]);
+
+        if (snap->width != width || snap->height != height) {
+            width = snap->width;
+            height = snap->height;
+            glViewport(0, 0, width, height);
+            c.version = 0;
+        }
 
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glUseProgram(prog);
-        uniform_model = glGetUniformLocation(prog, "model");
-        uniform_projection = glGetUniformLocation(prog, "projection");
-        uniform_view = glGetUniformLocation(prog, "view");
-
-        mat4 model;
-        glm_mat4_identity(model);
-        glm_translate(model, (vec3) {0.0f, 0.0f, -2.5f});
-        glm_scale(model, (vec3) {0.4f, 0.4f, 1.0f});
-        glUniformMatrix4fv(uniform_model, 1, GL_FALSE, P_GLUMAT(model));
-        glUniformMatrix4fv(uniform_projection, 1, GL_FALSE, P_GLUMAT(projection));
-        mat4 view;
-        glm_lookat(
-            c.pos,
-            VEC3_SUM(c.pos, c.front),
-            c.up,
-            view
-        );
-        glUniformMatrix4fv(uniform_view, 1, GL_FALSE, &view[0][0]);
-        render_mesh(mesh_arr[0]);
-
-        glm_mat4_identity(model);
-        glm_translate(model, (vec3) {0.0f, 1.0f, -2.5f});
-        glm_scale(model, (vec3) {0.4f, 0.4f, 1.0f});
-        glUniformMatrix4fv(uniform_model, 1, GL_FALSE, &model[0][0]);
-        render_mesh(mesh_arr[1]);
+        const Camera *view = &snap->camera;
+        if (playing) {
+            camera_refresh(&play);
+            view = &play;
+        }
+        frame.camera_changed = view->version != c.version;
+        if (frame.camera_changed) {
+            c = *view;
+            frame.lod.proj_scale = lod_projection_scale(c.projection, height);
+        }
+
+        /* The camera block is shared by every program through its binding
+         * point. It is written every frame, as the ring region holding it
+         * is reused a few frames later, and costs one memcpy and a bind. */
+        GLintptr camera_offset;
+        mat4 *camera_block = stream_alloc(&stream, sizeof(mat4) * 2, stream.uniform_align, &camera_offset);
+        if (camera_block) {
+            memcpy(camera_block[0], c.projection, sizeof(mat4));
+            memcpy(camera_block[1], c.view_matrix, sizeof(mat4));
+            stream_flush(&stream);
+            glBindBufferRange(GL_UNIFORM_BUFFER, UNIFORM_CAMERA, stream.buffer, camera_offset, sizeof(mat4) * 2);
+        }
+
+        frame.lod.camera = &c;
+        frame_graph_run(&graph);
+        stream_end_frame(&stream);
+
+        /* Once per frame, so the metrics cost a few adds whatever the
+         * draw count. */
+        lod_stats_reset(&total);
+        for (int i = 0; i < JOB_MAX_WORKERS; i++)
+            lod_stats_add(&total, &lod_stats[i]);
+        metrics_add(METRIC_DRAWS, total.draws);
+        metrics_add(METRIC_TRIANGLES, total.triangles);
+        metrics_add(METRIC_CULLED, total.culled);
 
         glUseProgram(0);
-        glfwSwapBuffers(window->win);
+        prof_gpu_end();
+        double submitted = window_time();
+        prof_begin("swap");
+        window_swap(window);
+        prof_end();
+        prof_end();
+        prof_frame_end();
+        gpumem_frame();
+        startup_done();
+
+        double now = window_time();
+        pacing_end_frame(&pacer, snap->input_time, now);
+        if (playing)
+            campath_frame_done(&path, now);
+        metrics_add(METRIC_FRAMES, 1);
+        if (last_swap > 0.0)
+            metrics_observe(METRIC_FRAME_SECONDS, now - last_swap);
+        last_swap = now;
+        thread_timing_add(&timing, submitted - start, (start - paced) + (now - submitted), now);
+        if (now - last_report >= 1.0) {
+            pacing_report(&pacer);
+            stream_report(&stream);
+            prof_report();
+            gl_debug_report();
+            lod_stats_log(&total);
+            job_stats_log();
+            job_stats_reset();
+            last_report = now;
+        }
+    }
+
+    if (playing)
+        campath_report(&path);
+    resource_report();
+    for (int i = 0; i < 2; i++)
+        lod_clear_mesh(&mesh_arr[i]);
+    gpumem_free(GPUMEM_BUFFER, instance_buffer);
+    glDeleteBuffers(1, &instance_buffer);
+    resource_release_program(prog);
+    stream_destroy(&stream);
+    pacing_destroy(&pacer);
+    cmd_queue_destroy(&queue);
+    job_shutdown();
+    prof_shutdown();
+    window_release_current(window);
+    return NULL;
+}
+
+/* The main thread owns the window: it polls events, runs the fixed-step
+ * simulation and publishes snapshots; it never touches GL after startup. */
+int main ()
+{
+    startup_begin();
+    metrics_init();
+    gpumem_init();
+    struct Window *window = init_window();
+
+    Camera c = init_camera(VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 1.0f, 1.0f), -90.0f, 0.0f, 5.0f, 0.01f);
+    camera_set_lens(&c, glm_rad(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    /* Simulation owns the last two ticks; c is rendered between them. */
+    Camera sim = c, sim_prev = c;
+
+    InputState input = {0};
+    Timestep clock;
+    timestep_init(&clock, TIMESTEP_RATE_AUTO, TIMESTEP_MAX_STEPS, window_time());
+    ThreadTiming timing = {.name = "main", .since = window_time()};
+    /* Headless runs and path playback are for measuring, so they always
+     * draw. */
+    playing = campath_init(&path);
+    redraw_init(&redraw, window->headless || playing ? 0 : -1);
+
+    /* The render thread starts from a complete snapshot. */
+    triple_init(&snapshot_buffer);
+    camera_refresh(&c);
+    snapshots[triple_read_slot(&snapshot_buffer)] = (RenderSnapshot) {c, window->b_width, window->b_height, 0, 0.0};
+
+    pthread_t renderer;
+    window_release_current(window);
+    if (pthread_create(&renderer, NULL, render_thread, window)) {
+        log_fatal("main: cannot start the render thread");
+        exit(1);
+    }
+
+    /* Playback ends the run from the render thread. */
+    while (!window_should_close(window) && atomic_load(&running)) {
+        double now = window_time();
+
+        window_poll(window);
+        unsigned int damage = window->damage;
+        window->damage = 0;
+        unsigned int events = 0;
+
+        /* Each tick sees the input stamped before the wall time it ends at. */
+        unsigned int steps = timestep_advance(&clock, now);
+        for (unsigned int i = 0; i < steps; i++) {
+            events += input_drain(&window->input, &input, now - clock.accumulator - (steps - 1 - i) * clock.step);
+            sim_prev = sim;
+            sim.key_control(&sim, &input, clock.step);
+            double tick_time = (clock.ticks - steps + 1 + i) * clock.step;
+            campath_record_input(&path, tick_time, &input, 0.0f, 0.0f);
+            campath_record_pose(&path, tick_time, &sim);
+        }
+
+        /* Mouse look is a per-frame delta, not a rate: apply all of it once
+         * and to both states so it isn't smoothed behind the cursor. */
+        float dx, dy;
+        events += input_drain(&window->input, &input, now);
+        input_take_mouse(&input, &dx, &dy);
+        sim.mouse_control(&sim, dx, dy);
+        campath_record_input(&path, clock.time, &input, dx, dy);
+        campath_record_pose(&path, clock.time, &sim);
+        sim_prev.yaw = sim.yaw;
+        sim_prev.pitch = sim.pitch;
+        camera_interpolate(&c, &sim_prev, &sim, clock.alpha);
+        if (camera_refresh(&c))
+            damage |= DAMAGE_CAMERA;
+        if (events)
+            damage |= DAMAGE_INPUT;
+
+        RenderSnapshot *snap = &snapshots[triple_write_slot(&snapshot_buffer)];
+        *snap = (RenderSnapshot) {c, window->b_width, window->b_height, clock.ticks, input.last_time};
+        triple_publish(&snapshot_buffer);
+        redraw_damage(&redraw, damage);
+
+        /* Sleep until the next tick is due or input arrives. With nothing
+         * held down on demand, nothing can change before the next event,
+         * but only once the last two ticks agree: until then the rendered
+         * pose is still interpolating towards where a released key left it. */
+        double busy = window_time() - now;
+        bool settled = glm_vec3_eqv(sim_prev.pos, sim.pos);
+        if (redraw.on_demand && !input_any_key(&input) && settled)
+            window_wait(window, REDRAW_IDLE_TIMEOUT);
+        else
+            window_wait(window, clock.step - clock.accumulator - busy);
+        thread_timing_add(&timing, busy, window_time() - now - busy, window_time());
     }
 
+    atomic_store(&running, false);
+    redraw_damage(&redraw, REDRAW_WAKE);
+    pthread_join(renderer, NULL);
+    redraw_destroy(&redraw);
+    campath_close(&path);
+    window_make_current(window);
+    destroy_window(window);
+    gpumem_shutdown();
+    metrics_shutdown();
     return 0;
 }
@@ -0,0 +1,247 @@
+#include "mathbatch.h"
+#include "log.h"
+#include <immintrin.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef void (*TrsFn)(const vec3 *, const versor *, const vec3 *, mat4 *, unsigned int);
+typedef void (*MulFn)(mat4, const mat4 *, mat4 *, unsigned int);
+
+/* Scalar reference, also used for the tails of the SIMD kernels.
+ * Rotations must be unit quaternions. */
+static void trs_one(const float *p, const float *r, const float *s, mat4 out)
+{
+    float x = r[0], y = r[1], z = r[2], w = r[3];
+    float xx = 2.0f * x * x, yy = 2.0f * y * y, zz = 2.0f * z * z;
+    float xy = 2.0f * x * y, xz = 2.0f * x * z, yz = 2.0f * y * z;
+    float wx = 2.0f * w * x, wy = 2.0f * w * y, wz = 2.0f * w * z;
+
+    out[0][0] = (1.0f - yy - zz) * s[0]; out[0][1] = (xy + wz) * s[0]; out[0][2] = (xz - wy) * s[0]; out[0][3] = 0.0f;
+    out[1][0] = (xy - wz) * s[1]; out[1][1] = (1.0f - xx - zz) * s[1]; out[1][2] = (yz + wx) * s[1]; out[1][3] = 0.0f;
+    out[2][0] = (xz + wy) * s[2]; out[2][1] = (yz - wx) * s[2]; out[2][2] = (1.0f - xx - yy) * s[2]; out[2][3] = 0.0f;
+    out[3][0] = p[0]; out[3][1] = p[1]; out[3][2] = p[2]; out[3][3] = 1.0f;
+}
+
+#define CAT(a, b) a##b
+
+/* Lane j of each helper covers transforms 4 * j .. 4 * j + 3. */
+__attribute__((target("sse4.1")))
+static inline __m128 load_sse(const float *base, unsigned int stride, int k)
+{
+    return _mm_loadu_ps(base + k * stride);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 load_avx2(const float *base, unsigned int stride, int k)
+{
+    __m256 v = _mm256_castps128_ps256(_mm_loadu_ps(base + k * stride));
+    return _mm256_insertf128_ps(v, _mm_loadu_ps(base + (4 + k) * stride), 1);
+}
+
+__attribute__((target("avx2")))
+static inline void store_avx2(mat4 *out, __m256 v, int k, int col)
+{
+    _mm_storeu_ps(out[k][col], _mm256_castps256_ps128(v));
+    _mm_storeu_ps(out[4 + k][col], _mm256_extractf128_ps(v, 1));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 load_avx512(const float *base, unsigned int stride, int k)
+{
+    __m512 v = _mm512_castps128_ps512(_mm_loadu_ps(base + k * stride));
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(base + (4 + k) * stride), 1);
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(base + (8 + k) * stride), 2);
+    return _mm512_insertf32x4(v, _mm_loadu_ps(base + (12 + k) * stride), 3);
+}
+
+__attribute__((target("avx512f")))
+static inline void store_avx512(mat4 *out, __m512 v, int k, int col)
+{
+    _mm_storeu_ps(out[k][col], _mm512_extractf32x4_ps(v, 0));
+    _mm_storeu_ps(out[4 + k][col], _mm512_extractf32x4_ps(v, 1));
+    _mm_storeu_ps(out[8 + k][col], _mm512_extractf32x4_ps(v, 2));
+    _mm_storeu_ps(out[12 + k][col], _mm512_extractf32x4_ps(v, 3));
+}
+
+#define KERNEL trs_sse41
+#define ISA "sse4.1"
+#define T __m128
+#define OP(op) CAT(_mm, op)
+#define LANES 1
+#define LOAD(base, stride, k) load_sse(base, stride, k)
+#define STORE(out, v, k, col) _mm_storeu_ps((out)[k][col], v)
+#include "mathbatch_kernel.h"
+
+#define KERNEL trs_avx2
+#define ISA "avx2"
+#define T __m256
+#define OP(op) CAT(_mm256, op)
+#define LANES 2
+#define LOAD(base, stride, k) load_avx2(base, stride, k)
+#define STORE(out, v, k, col) store_avx2(out, v, k, col)
+#include "mathbatch_kernel.h"
+
+#define KERNEL trs_avx512
+#define ISA "avx512f"
+#define T __m512
+#define OP(op) CAT(_mm512, op)
+#define LANES 4
+#define LOAD(base, stride, k) load_avx512(base, stride, k)
+#define STORE(out, v, k, col) store_avx512(out, v, k, col)
+#include "mathbatch_kernel.h"
+
+static void trs_scalar(const vec3 *p, const versor *r, const vec3 *s, mat4 *out, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++)
+        trs_one(p[i], r[i], s[i], out[i]);
+}
+
+static void mul_scalar(mat4 m, const mat4 *in, mat4 *out, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        mat4 r;
+        for (int c = 0; c < 4; c++)
+            for (int row = 0; row < 4; row++)
+                r[c][row] = m[0][row] * in[i][c][0] + m[1][row] * in[i][c][1]
+                          + m[2][row] * in[i][c][2] + m[3][row] * in[i][c][3];
+        memcpy(out[i], r, sizeof(mat4));
+    }
+}
+
+/* Column c of the result is m times column c of in[i]: one broadcast and
+ * multiply-add per column of m. */
+__attribute__((target("sse4.1")))
+static void mul_sse41(mat4 m, const mat4 *in, mat4 *out, unsigned int count)
+{
+    __m128 a0 = _mm_loadu_ps(m[0]), a1 = _mm_loadu_ps(m[1]);
+    __m128 a2 = _mm_loadu_ps(m[2]), a3 = _mm_loadu_ps(m[3]);
+
+    for (unsigned int i = 0; i < count; i++) {
+        __m128 b[4];
+        for (int c = 0; c < 4; c++)
+            b[c] = _mm_loadu_ps(in[i][c]);
+        for (int c = 0; c < 4; c++) {
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(b[c], b[c], 0x00));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(b[c], b[c], 0x55)));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(b[c], b[c], 0xaa)));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(b[c], b[c], 0xff)));
+            _mm_storeu_ps(out[i][c], r);
+        }
+    }
+}
+
+/* Two result columns per register: m's columns repeat in both halves and
+ * the in-lane permute broadcasts each half's own column element. */
+__attribute__((target("avx2,fma")))
+static void mul_avx2(mat4 m, const mat4 *in, mat4 *out, unsigned int count)
+{
+    __m256 a0 = _mm256_broadcast_ps((const __m128 *) m[0]), a1 = _mm256_broadcast_ps((const __m128 *) m[1]);
+    __m256 a2 = _mm256_broadcast_ps((const __m128 *) m[2]), a3 = _mm256_broadcast_ps((const __m128 *) m[3]);
+
+    for (unsigned int i = 0; i < count; i++) {
+        __m256 b01 = _mm256_loadu_ps(in[i][0]), b23 = _mm256_loadu_ps(in[i][2]);
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xaa), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xaa), r23);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xff), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xff), r23);
+        _mm256_storeu_ps(out[i][0], r01);
+        _mm256_storeu_ps(out[i][2], r23);
+    }
+}
+
+/* Same as AVX2 with the whole matrix in one register. */
+__attribute__((target("avx512f")))
+static void mul_avx512(mat4 m, const mat4 *in, mat4 *out, unsigned int count)
+{
+    __m512 a0 = _mm512_broadcast_f32x4(_mm_loadu_ps(m[0])), a1 = _mm512_broadcast_f32x4(_mm_loadu_ps(m[1]));
+    __m512 a2 = _mm512_broadcast_f32x4(_mm_loadu_ps(m[2])), a3 = _mm512_broadcast_f32x4(_mm_loadu_ps(m[3]));
+
+    for (unsigned int i = 0; i < count; i++) {
+        __m512 b = _mm512_loadu_ps(in[i][0]);
+        __m512 r = _mm512_mul_ps(a0, _mm512_permute_ps(b, 0x00));
+        r = _mm512_fmadd_ps(a1, _mm512_permute_ps(b, 0x55), r);
+        r = _mm512_fmadd_ps(a2, _mm512_permute_ps(b, 0xaa), r);
+        r = _mm512_fmadd_ps(a3, _mm512_permute_ps(b, 0xff), r);
+        _mm512_storeu_ps(out[i][0], r);
+    }
+}
+
+static const struct {
+    const char *name;
+    TrsFn trs;
+    MulFn mul;
+} kernels[MATH_ISA_COUNT] = {
+    [MATH_ISA_SCALAR] = {"scalar", trs_scalar, mul_scalar},
+    [MATH_ISA_SSE41] = {"sse4.1", trs_sse41, mul_sse41},
+    [MATH_ISA_AVX2] = {"avx2", trs_avx2, mul_avx2},
+    [MATH_ISA_AVX512] = {"avx512", trs_avx512, mul_avx512},
+};
+
+static MathIsa current = MATH_ISA_SCALAR;
+
+bool mathbatch_supported(MathIsa isa)
+{
+    __builtin_cpu_init();
+    switch (isa) {
+    case MATH_ISA_SCALAR:
+        return true;
+    case MATH_ISA_SSE41:
+        return __builtin_cpu_supports("sse4.1");
+    case MATH_ISA_AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case MATH_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+    default:
+        return false;
+    }
+}
+
+bool mathbatch_set_isa(MathIsa isa)
+{
+    if (!mathbatch_supported(isa))
+        return false;
+    current = isa;
+    return true;
+}
+
+MathIsa mathbatch_isa()
+{
+    return current;
+}
+
+const char *mathbatch_isa_name(MathIsa isa)
+{
+    return isa < MATH_ISA_COUNT ? kernels[isa].name : "unknown";
+}
+
+void mathbatch_init()
+{
+    MathIsa limit = MATH_ISA_COUNT - 1;
+    const char *env = getenv("MATH_ISA");
+
+    if (env) {
+        for (int i = 0; i < MATH_ISA_COUNT; i++)
+            if (!strcmp(env, kernels[i].name))
+                limit = i;
+    }
+
+    for (int isa = limit; isa >= 0; isa--) {
+        if (mathbatch_set_isa(isa))
+            break;
+    }
+    log_info("mathbatch: using %s kernels", mathbatch_isa_name(current));
+}
+
+void batch_trs(const vec3 *position, const versor *rotation, const vec3 *scale, mat4 *out, unsigned int count)
+{
+    kernels[current].trs(position, rotation, scale, out, count);
+}
+
+void batch_mat4_mul(mat4 m, const mat4 *in, mat4 *out, unsigned int count)
+{
+    kernels[current].mul(m, in, out, count);
+}
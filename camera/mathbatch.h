@@ -0,0 +1,24 @@
+#pragma once
+#include <stdbool.h>
+#include <cglm/cglm.h>
+
+typedef enum {
+    MATH_ISA_SCALAR,
+    MATH_ISA_SSE41,
+    MATH_ISA_AVX2,
+    MATH_ISA_AVX512,
+    MATH_ISA_COUNT
+} MathIsa;
+
+/* Picks the widest kernels the CPU supports; $MATH_ISA (scalar, sse4.1,
+ * avx2, avx512) forces a narrower set. */
+void mathbatch_init(void);
+bool mathbatch_set_isa(MathIsa isa);
+bool mathbatch_supported(MathIsa isa);
+MathIsa mathbatch_isa(void);
+const char *mathbatch_isa_name(MathIsa isa);
+
+/* out[i] = T(position[i]) * R(rotation[i]) * S(scale[i]) */
+void batch_trs(const vec3 *position, const versor *rotation, const vec3 *scale, mat4 *out, unsigned int count);
+/* out[i] = m * in[i], e.g. view-projection times model. in and out may alias. */
+void batch_mat4_mul(mat4 m, const mat4 *in, mat4 *out, unsigned int count);
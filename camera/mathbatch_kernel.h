@@ -0,0 +1,77 @@
+/* SIMD TRS kernel template, included by mathbatch.c once per ISA with
+ *   KERNEL  function name
+ *   ISA     target attribute string
+ *   T       register type
+ *   OP(op)  intrinsic for T, e.g. OP(_mul_ps)
+ *   LANES   128-bit lanes per register
+ *   LOAD(base, stride, k)    row k of every lane: base + (4 * lane + k) * stride floats
+ *   STORE(out, v, k, col)    lane j of v to column col of out[4 * j + k]
+ * Each 128-bit lane transposes four AoS inputs into SoA, so one register
+ * holds the same component of 4 * LANES consecutive transforms. No include
+ * guard on purpose. */
+
+#define TRANSPOSE4(a, b, c, d) do { \
+    T t0 = OP(_unpacklo_ps)(a, b), t1 = OP(_unpacklo_ps)(c, d); \
+    T t2 = OP(_unpackhi_ps)(a, b), t3 = OP(_unpackhi_ps)(c, d); \
+    a = OP(_shuffle_ps)(t0, t1, 0x44); b = OP(_shuffle_ps)(t0, t1, 0xee); \
+    c = OP(_shuffle_ps)(t2, t3, 0x44); d = OP(_shuffle_ps)(t2, t3, 0xee); \
+} while (0)
+
+__attribute__((target(ISA)))
+static void KERNEL(const vec3 *p, const versor *r, const vec3 *s, mat4 *out, unsigned int count)
+{
+    const unsigned int width = 4 * LANES;
+    const T one = OP(_set1_ps)(1.0f), two = OP(_set1_ps)(2.0f), zero = OP(_setzero_ps)();
+    unsigned int i = 0;
+
+    /* vec3 rows are read as four floats, so stay clear of the array end. */
+    for (; i + width < count; i += width) {
+        T x = LOAD(r[i], 4, 0), y = LOAD(r[i], 4, 1), z = LOAD(r[i], 4, 2), w = LOAD(r[i], 4, 3);
+        T px = LOAD(p[i], 3, 0), py = LOAD(p[i], 3, 1), pz = LOAD(p[i], 3, 2), pw = LOAD(p[i], 3, 3);
+        T sx = LOAD(s[i], 3, 0), sy = LOAD(s[i], 3, 1), sz = LOAD(s[i], 3, 2), sw = LOAD(s[i], 3, 3);
+        TRANSPOSE4(x, y, z, w);
+        TRANSPOSE4(px, py, pz, pw);
+        TRANSPOSE4(sx, sy, sz, sw);
+
+        T x2 = OP(_mul_ps)(two, x), y2 = OP(_mul_ps)(two, y), z2 = OP(_mul_ps)(two, z);
+        T xx = OP(_mul_ps)(x2, x), yy = OP(_mul_ps)(y2, y), zz = OP(_mul_ps)(z2, z);
+        T xy = OP(_mul_ps)(x2, y), xz = OP(_mul_ps)(x2, z), yz = OP(_mul_ps)(y2, z);
+        T wx = OP(_mul_ps)(x2, w), wy = OP(_mul_ps)(y2, w), wz = OP(_mul_ps)(z2, w);
+
+        T c0x = OP(_mul_ps)(OP(_sub_ps)(one, OP(_add_ps)(yy, zz)), sx);
+        T c0y = OP(_mul_ps)(OP(_add_ps)(xy, wz), sx);
+        T c0z = OP(_mul_ps)(OP(_sub_ps)(xz, wy), sx);
+        T c0w = zero;
+        T c1x = OP(_mul_ps)(OP(_sub_ps)(xy, wz), sy);
+        T c1y = OP(_mul_ps)(OP(_sub_ps)(one, OP(_add_ps)(xx, zz)), sy);
+        T c1z = OP(_mul_ps)(OP(_add_ps)(yz, wx), sy);
+        T c1w = zero;
+        T c2x = OP(_mul_ps)(OP(_add_ps)(xz, wy), sz);
+        T c2y = OP(_mul_ps)(OP(_sub_ps)(yz, wx), sz);
+        T c2z = OP(_mul_ps)(OP(_sub_ps)(one, OP(_add_ps)(xx, yy)), sz);
+        T c2w = zero;
+        pw = one;
+
+        TRANSPOSE4(c0x, c0y, c0z, c0w);
+        TRANSPOSE4(c1x, c1y, c1z, c1w);
+        TRANSPOSE4(c2x, c2y, c2z, c2w);
+        TRANSPOSE4(px, py, pz, pw);
+
+        STORE(out + i, c0x, 0, 0); STORE(out + i, c0y, 1, 0); STORE(out + i, c0z, 2, 0); STORE(out + i, c0w, 3, 0);
+        STORE(out + i, c1x, 0, 1); STORE(out + i, c1y, 1, 1); STORE(out + i, c1z, 2, 1); STORE(out + i, c1w, 3, 1);
+        STORE(out + i, c2x, 0, 2); STORE(out + i, c2y, 1, 2); STORE(out + i, c2z, 2, 2); STORE(out + i, c2w, 3, 2);
+        STORE(out + i, px, 0, 3); STORE(out + i, py, 1, 3); STORE(out + i, pz, 2, 3); STORE(out + i, pw, 3, 3);
+    }
+
+    for (; i < count; i++)
+        trs_one(p[i], r[i], s[i], out[i]);
+}
+
+#undef TRANSPOSE4
+#undef KERNEL
+#undef ISA
+#undef T
+#undef OP
+#undef LANES
+#undef LOAD
+#undef STORE
@@ -0,0 +1,106 @@
+#include "mathbatch.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define COUNT 4096
+#define ROUNDS 2000
+#define TOLERANCE 1e-4f
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static float frand(float lo, float hi)
+{
+    return lo + (hi - lo) * rand() / (float) RAND_MAX;
+}
+
+static float max_error(const mat4 *a, const mat4 *b, unsigned int count)
+{
+    float err = 0.0f;
+    for (unsigned int i = 0; i < count; i++)
+        for (int c = 0; c < 4; c++)
+            for (int r = 0; r < 4; r++)
+                err = fmaxf(err, fabsf(a[i][c][r] - b[i][c][r]));
+    return err;
+}
+
+/* Check every supported kernel set against cglm, then report throughput. */
+int main()
+{
+    vec3 *pos = malloc(sizeof(vec3) * COUNT);
+    versor *rot = aligned_alloc(16, sizeof(versor) * COUNT);
+    vec3 *scale = malloc(sizeof(vec3) * COUNT);
+    mat4 *ref_trs = aligned_alloc(32, sizeof(mat4) * COUNT);
+    mat4 *ref_mul = aligned_alloc(32, sizeof(mat4) * COUNT);
+    mat4 *out = aligned_alloc(32, sizeof(mat4) * COUNT);
+    mat4 vp, view, proj;
+    int failed = 0;
+
+    srand(1);
+    for (unsigned int i = 0; i < COUNT; i++) {
+        pos[i][0] = frand(-100, 100); pos[i][1] = frand(-100, 100); pos[i][2] = frand(-100, 100);
+        glm_quatv(rot[i], frand(-3.14f, 3.14f), (vec3) {frand(-1, 1), frand(-1, 1), frand(0.1f, 1)});
+        scale[i][0] = frand(0.1f, 4); scale[i][1] = frand(0.1f, 4); scale[i][2] = frand(0.1f, 4);
+
+        glm_translate_make(ref_trs[i], pos[i]);
+        glm_quat_rotate(ref_trs[i], rot[i], ref_trs[i]);
+        glm_scale(ref_trs[i], scale[i]);
+    }
+
+    glm_perspective(glm_rad(45.0f), 16.0f / 9.0f, 0.1f, 100.0f, proj);
+    glm_lookat((vec3) {1, 2, 3}, (vec3) {0, 0, -5}, (vec3) {0, 1, 0}, view);
+    glm_mat4_mul(proj, view, vp);
+    for (unsigned int i = 0; i < COUNT; i++)
+        glm_mat4_mul(vp, ref_trs[i], ref_mul[i]);
+
+    for (int isa = 0; isa < MATH_ISA_COUNT; isa++) {
+        const char *name = mathbatch_isa_name(isa);
+        if (!mathbatch_set_isa(isa)) {
+            log_info("%-7s not supported by this CPU", name);
+            continue;
+        }
+
+        batch_trs(pos, rot, scale, out, COUNT);
+        float trs_err = max_error(out, ref_trs, COUNT);
+        batch_mat4_mul(vp, (const mat4 *) ref_trs, out, COUNT);
+        float mul_err = max_error(out, ref_mul, COUNT);
+        if (trs_err > TOLERANCE || mul_err > TOLERANCE * 100) {
+            log_error("%-7s mismatch against cglm: trs %g, mul %g", name, trs_err, mul_err);
+            failed = 1;
+        }
+
+        double t = now();
+        for (int r = 0; r < ROUNDS; r++)
+            batch_trs(pos, rot, scale, out, COUNT);
+        double trs_rate = (double) COUNT * ROUNDS / (now() - t);
+
+        t = now();
+        for (int r = 0; r < ROUNDS; r++)
+            batch_mat4_mul(vp, (const mat4 *) ref_trs, out, COUNT);
+        double mul_rate = (double) COUNT * ROUNDS / (now() - t);
+
+        log_info("%-7s trs %7.1f M/s  mul %7.1f M/s  (max error %.2g / %.2g)",
+                 name, trs_rate * 1e-6, mul_rate * 1e-6, trs_err, mul_err);
+    }
+
+    double t = now();
+    for (int r = 0; r < ROUNDS; r++)
+        for (unsigned int i = 0; i < COUNT; i++)
+            glm_mat4_mul(vp, ref_trs[i], out[i]);
+    log_info("%-7s mul %7.1f M/s", "cglm", (double) COUNT * ROUNDS / (now() - t) * 1e-6);
+
+    free(pos);
+    free(rot);
+    free(scale);
+    free(ref_trs);
+    free(ref_mul);
+    free(out);
+    return failed;
+}
@@ -0,0 +1,71 @@
+#include "mesh.h"
+#include "gl_debug.h"
+#include "resource.h"
+
+void create_mesh(GLuint mesh[4], GLfloat *vertices, unsigned int *indices, unsigned int len_vertices, unsigned int len_indices)
+{
+    mesh[INDEX_COUNT] = len_indices;
+    glGenVertexArrays(1, &mesh[VAO]);
+    glBindVertexArray(mesh[VAO]);
+
+    /* Meshes with the same content share buffers; the VAO is per mesh. */
+    mesh[IBO] = resource_buffer(GPUMEM_INDICES, indices, sizeof(indices[0]) * len_indices);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh[IBO]);
+
+    mesh[VBO] = resource_buffer(GPUMEM_VERTICES, vertices, sizeof(vertices[0]) * len_vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh[VBO]);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    glEnableVertexAttribArray(0);
+
+    /* The element buffer binding is VAO state; it stays bound. */
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    gl_debug_label(GL_VERTEX_ARRAY, mesh[VAO], "mesh %u", mesh[VAO]);
+}
+
+void render_mesh(GLuint mesh[4])
+{
+    glBindVertexArray(mesh[VAO]);
+    glDrawElements(GL_TRIANGLES, mesh[INDEX_COUNT], GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+void clear_mesh(GLuint mesh[4])
+{
+    if (mesh[IBO]) {
+        resource_release_buffer(mesh[IBO]);
+        mesh[IBO] = 0;
+    }
+
+    if (mesh[VBO]) {
+        resource_release_buffer(mesh[VBO]);
+        mesh[VBO] = 0;
+    }
+
+    if (mesh[VAO]) {
+        glDeleteVertexArrays(1, &mesh[VAO]);
+        mesh[VAO] = 0;
+    }
+
+    mesh[INDEX_COUNT] = 0;
+}
+
+/* Point the per-instance model matrix (attributes 1-4) at one mat4 of an
+ * instance buffer. Non-instanced draws read instance 0, i.e. that matrix. */
+void mesh_set_instance(GLuint mesh[4], GLuint buffer, unsigned int index)
+{
+    glBindVertexArray(mesh[VAO]);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    for (int col = 0; col < 4; col++) {
+        glVertexAttribPointer(1 + col, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 16,
+                              (void *) (sizeof(GLfloat) * (16 * index + 4 * col)));
+        glEnableVertexAttribArray(1 + col);
+        glVertexAttribDivisor(1 + col, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
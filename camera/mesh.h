@@ -0,0 +1,14 @@
+#pragma once
+#include "gl_loader.h"
+
+enum {
+    VAO,
+    VBO,
+    IBO,
+    INDEX_COUNT
+};
+
+void create_mesh(GLuint mesh[4], GLfloat *vertices, unsigned int *indices, unsigned int len_vertices, unsigned int len_indices);
+void render_mesh(GLuint mesh[4]);
+void clear_mesh(GLuint mesh[4]);
+void mesh_set_instance(GLuint mesh[4], GLuint buffer, unsigned int index);
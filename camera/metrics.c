@@ -0,0 +1,193 @@
+#include "metrics.h"
+#include "log.h"
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+typedef struct {
+    const char *name, *help;
+    MetricType type;
+    double scale;               /* exported value per stored unit */
+} MetricInfo;
+
+static const MetricInfo info[METRIC_COUNT] = {
+    [METRIC_FRAMES] = {"camera_frames_total", "Frames swapped.", METRIC_COUNTER, 1.0},
+    [METRIC_FRAME_SECONDS] = {"camera_frame_seconds", "Swap-to-swap frame time.", METRIC_HISTOGRAM, 1e-9},
+    [METRIC_DRAWS] = {"camera_draw_calls_total", "Draw calls submitted.", METRIC_COUNTER, 1.0},
+    [METRIC_TRIANGLES] = {"camera_triangles_total", "Triangles submitted.", METRIC_COUNTER, 1.0},
+    [METRIC_CULLED] = {"camera_culled_objects_total", "Objects culled against the view frustum.", METRIC_COUNTER, 1.0},
+    [METRIC_GPU_BYTES] = {"camera_gpu_memory_bytes", "GPU memory allocated for buffers, textures and renderbuffers.", METRIC_GAUGE, 1.0},
+    [METRIC_GPU_EVICTIONS] = {"camera_gpu_evictions_total", "Resources evicted to stay within the GPU memory budget.", METRIC_COUNTER, 1.0},
+    [METRIC_SHADER_COMPILES] = {"camera_shader_compiles_total", "Shaders compiled.", METRIC_COUNTER, 1.0},
+};
+
+/* Upper bounds in seconds; the last bucket takes the rest. */
+static const double bounds[METRICS_BUCKETS - 1] = {0.001, 0.002, 0.004, 0.008, 0.0167, 0.0333, 0.05, 0.1, 0.25};
+
+/* For histograms metric_values holds the sum, in nanoseconds. */
+_Atomic int64_t metric_values[METRIC_COUNT];
+static _Atomic uint64_t buckets[METRIC_COUNT][METRICS_BUCKETS];
+
+static struct {
+    pthread_t thread;
+    int fd;
+    atomic_bool stop;
+    char unix_path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+} server = {.fd = -1};
+
+void metrics_observe(MetricId id, double value)
+{
+    int b = 0;
+    while (b < METRICS_BUCKETS - 1 && value > bounds[b])
+        b++;
+    atomic_fetch_add_explicit(&buckets[id][b], 1, memory_order_relaxed);
+    metrics_add(id, (int64_t) (value / info[id].scale));
+}
+
+/* Values are read one at a time, so a scrape may see a frame half added;
+ * Prometheus tolerates that. */
+static void format(FILE *out)
+{
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        const MetricInfo *m = &info[i];
+        static const char *types[] = {"counter", "gauge", "histogram"};
+        double value = atomic_load_explicit(&metric_values[i], memory_order_relaxed) * m->scale;
+        fprintf(out, "# HELP %s %s\n# TYPE %s %s\n", m->name, m->help, m->name, types[m->type]);
+        if (m->type != METRIC_HISTOGRAM) {
+            fprintf(out, "%s %.17g\n", m->name, value);
+            continue;
+        }
+        uint64_t count = 0;
+        for (int b = 0; b < METRICS_BUCKETS; b++) {
+            count += atomic_load_explicit(&buckets[i][b], memory_order_relaxed);
+            if (b < METRICS_BUCKETS - 1)
+                fprintf(out, "%s_bucket{le=\"%g\"} %llu\n", m->name, bounds[b], (unsigned long long) count);
+            else
+                fprintf(out, "%s_bucket{le=\"+Inf\"} %llu\n", m->name, (unsigned long long) count);
+        }
+        fprintf(out, "%s_sum %.9f\n%s_count %llu\n", m->name, value, m->name, (unsigned long long) count);
+    }
+}
+
+static void respond(int fd)
+{
+    /* The request itself doesn't matter; read it so the client sees a
+     * clean close, giving up after a second. */
+    char request[1024];
+    struct timeval timeout = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    recv(fd, request, sizeof(request), 0);
+
+    static char body[METRICS_BODY_MAX];
+    FILE *out = fmemopen(body, sizeof(body), "w");
+    if (!out)
+        return;
+    format(out);
+    long size = ftell(out);
+    fclose(out);
+
+    char header[128];
+    int len = snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                       "Content-Length: %ld\r\n\r\n", size);
+    if (send(fd, header, len, MSG_NOSIGNAL) == len)
+        send(fd, body, size, MSG_NOSIGNAL);
+}
+
+/* Polls so metrics_shutdown() is noticed within a quarter second. */
+static void *serve(void *arg)
+{
+    (void) arg;
+    while (!atomic_load(&server.stop)) {
+        struct pollfd p = {server.fd, POLLIN, 0};
+        if (poll(&p, 1, 250) <= 0)
+            continue;
+        int fd = accept(server.fd, NULL, NULL);
+        if (fd < 0)
+            continue;
+        respond(fd);
+        close(fd);
+    }
+    return NULL;
+}
+
+static int listen_unix(const char *path)
+{
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        log_error("metrics: socket path too long: %s", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    unlink(path);
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) || listen(fd, 8)) {
+        close(fd);
+        return -1;
+    }
+    strcpy(server.unix_path, path);
+    return fd;
+}
+
+static int listen_tcp(int port)
+{
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port),
+                               .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) || listen(fd, 8)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void metrics_init(void)
+{
+    const char *path = getenv("METRICS_SOCKET");
+    const char *port = getenv("METRICS_PORT");
+
+    if (path && *path)
+        server.fd = listen_unix(path);
+    else if (port && *port)
+        server.fd = listen_tcp(atoi(port));
+    else
+        return;
+
+    if (server.fd < 0) {
+        log_error("metrics: can't listen on %s: %s", path && *path ? path : port, strerror(errno));
+        return;
+    }
+    if (pthread_create(&server.thread, NULL, serve, NULL)) {
+        log_error("metrics: cannot start the server thread");
+        close(server.fd);
+        server.fd = -1;
+        return;
+    }
+    log_info("metrics: serving on %s%s", path && *path ? "" : "127.0.0.1:", path && *path ? path : port);
+}
+
+void metrics_shutdown(void)
+{
+    if (server.fd < 0)
+        return;
+    atomic_store(&server.stop, true);
+    pthread_join(server.thread, NULL);
+    close(server.fd);
+    server.fd = -1;
+    if (server.unix_path[0])
+        unlink(server.unix_path);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define METRICS_BUCKETS 10          /* histogram buckets, the last one is +Inf */
+#define METRICS_BODY_MAX (64 << 10)
+
+typedef enum {
+    METRIC_FRAMES,
+    METRIC_FRAME_SECONDS,
+    METRIC_DRAWS,
+    METRIC_TRIANGLES,
+    METRIC_CULLED,
+    METRIC_GPU_BYTES,
+    METRIC_GPU_EVICTIONS,
+    METRIC_SHADER_COMPILES,
+    METRIC_COUNT
+} MetricId;
+
+typedef enum {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+} MetricType;
+
+/* Renderer telemetry for scraping in production.
+ *
+ * Every metric is a fixed slot updated with relaxed atomics, so an update
+ * from the render thread or a worker is a single uncontended add. Nothing
+ * is locked or allocated per frame. metrics_init() starts a server thread
+ * when $METRICS_SOCKET (a Unix socket path) or $METRICS_PORT (TCP on
+ * 127.0.0.1) is set. It answers every HTTP request with the current values
+ * in the Prometheus text format, e.g.
+ *
+ *     curl --unix-socket /tmp/camera.sock http://localhost/metrics
+ *
+ * Histograms are cumulative over the whole run, like the counters. */
+void metrics_init(void);
+void metrics_shutdown(void);
+void metrics_observe(MetricId id, double value);
+
+extern _Atomic int64_t metric_values[METRIC_COUNT];
+
+static inline void metrics_add(MetricId id, int64_t n)
+{
+    atomic_fetch_add_explicit(&metric_values[id], n, memory_order_relaxed);
+}
+
+static inline void metrics_set(MetricId id, int64_t v)
+{
+    atomic_store_explicit(&metric_values[id], v, memory_order_relaxed);
+}
@@ -0,0 +1,115 @@
+#include "pacing.h"
+#include "window.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void pacing_init(FramePacer *p, int max_in_flight, double fps)
+{
+    memset(p, 0, sizeof(*p));
+
+    if (max_in_flight <= 0) {
+        const char *env = getenv("FRAMES_IN_FLIGHT");
+        max_in_flight = env ? atoi(env) : 2;
+    }
+    if (max_in_flight < 1)
+        max_in_flight = 1;
+    if (max_in_flight > PACING_MAX_IN_FLIGHT)
+        max_in_flight = PACING_MAX_IN_FLIGHT;
+    if (fps < 0.0) {
+        const char *env = getenv("FPS_LIMIT");
+        fps = env ? atof(env) : 0.0;
+    }
+
+    p->max_in_flight = max_in_flight;
+    p->interval = fps > 0.0 ? 1.0 / fps : 0.0;
+    p->deadline = window_time();
+    if (fps > 0.0)
+        log_info("pacing: %d frame(s) in flight, limited to %.1f fps", max_in_flight, fps);
+    else
+        log_info("pacing: %d frame(s) in flight, no frame rate limit", max_in_flight);
+}
+
+void pacing_destroy(FramePacer *p)
+{
+    for (int i = 0; i < PACING_MAX_IN_FLIGHT; i++)
+        if (p->fences[i])
+            glDeleteSync(p->fences[i]);
+    memset(p->fences, 0, sizeof(p->fences));
+}
+
+/* Sleep most of the way, then spin: nanosleep overshoots by up to a
+ * scheduler tick, which is more than a frame's slack at high rates. */
+static void wait_until(double deadline)
+{
+    double left = deadline - window_time();
+    if (left > PACING_SPIN_SECONDS) {
+        double sleep = left - PACING_SPIN_SECONDS;
+        struct timespec t = {(time_t) sleep, (long) ((sleep - (time_t) sleep) * 1e9)};
+        nanosleep(&t, NULL);
+    }
+    while (window_time() < deadline);
+}
+
+/* Call before sampling input for the frame: blocks until the GPU has
+ * finished the frame max_in_flight back, then until the limiter allows
+ * the next one, so the input it reads afterwards is as fresh as possible. */
+void pacing_begin_frame(FramePacer *p)
+{
+    double start = window_time();
+    GLsync *fence = &p->fences[p->frame % p->max_in_flight];
+    if (*fence) {
+        glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(*fence);
+        *fence = NULL;
+    }
+    double fenced = window_time();
+    p->fence_wait += fenced - start;
+
+    if (p->interval > 0.0) {
+        /* After a long stall restart the schedule rather than bursting. */
+        if (p->deadline < fenced - p->interval)
+            p->deadline = fenced;
+        wait_until(p->deadline);
+        p->deadline += p->interval;
+        p->limit_wait += window_time() - fenced;
+    }
+}
+
+/* Call after the swap. input_time is the newest input event the frame
+ * included; a sample is taken each time it moves forward. */
+void pacing_end_frame(FramePacer *p, double input_time, double swap_time)
+{
+    p->fences[p->frame % p->max_in_flight] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    p->frame++;
+
+    if (input_time > p->last_input) {
+        p->last_input = input_time;
+        p->latency[p->latency_count++ % PACING_SAMPLES] = (swap_time - input_time) * 1e3;
+    }
+}
+
+static int float_cmp(const void *a, const void *b)
+{
+    float fa = *(const float *) a, fb = *(const float *) b;
+    return fa < fb ? -1 : fa > fb;
+}
+
+/* Logs waits and latency percentiles since the last report, then resets. */
+void pacing_report(FramePacer *p)
+{
+    unsigned int n = p->latency_count < PACING_SAMPLES ? p->latency_count : PACING_SAMPLES;
+    log_info("pacing: %.1f ms fence wait, %.1f ms limiter wait", p->fence_wait * 1e3, p->limit_wait * 1e3);
+
+    if (n) {
+        float sorted[PACING_SAMPLES];
+        memcpy(sorted, p->latency, sizeof(float) * n);
+        qsort(sorted, n, sizeof(float), float_cmp);
+        log_info("pacing: input-to-swap latency over %u samples: p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms",
+                 n, sorted[n / 2], sorted[n * 9 / 10], sorted[n * 99 / 100], sorted[n - 1]);
+    }
+
+    p->fence_wait = p->limit_wait = 0.0;
+    p->latency_count = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "gl_loader.h"
+
+#define PACING_MAX_IN_FLIGHT 3
+#define PACING_SPIN_SECONDS 0.001   /* final stretch of a limiter wait is spun, not slept */
+#define PACING_SAMPLES 1024
+
+/* Frame pacing for the render thread: caps how many frames the driver may
+ * queue with fence syncs, optionally limits the frame rate, and records
+ * input-to-swap latency. */
+typedef struct {
+    GLsync fences[PACING_MAX_IN_FLIGHT];
+    unsigned long frame;
+    int max_in_flight;
+    double interval;            /* seconds per frame, 0 for no limit */
+    double deadline;            /* when the next frame may start */
+
+    double fence_wait, limit_wait;              /* seconds since last report */
+    double last_input;
+    float latency[PACING_SAMPLES];              /* milliseconds, ring */
+    unsigned int latency_count;
+} FramePacer;
+
+/* max_in_flight 0 reads $FRAMES_IN_FLIGHT (default 2); fps < 0 reads
+ * $FPS_LIMIT (default 0, unlimited). */
+void pacing_init(FramePacer *p, int max_in_flight, double fps);
+void pacing_destroy(FramePacer *p);
+void pacing_begin_frame(FramePacer *p);
+void pacing_end_frame(FramePacer *p, double input_time, double swap_time);
+void pacing_report(FramePacer *p);
@@ -0,0 +1,336 @@
+#include "profile.h"
+#include "gl_loader.h"
+#include "log.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    const char *name;
+    uint64_t start, end;        /* ns, CLOCK_MONOTONIC */
+} ProfEvent;
+
+typedef struct {
+    int tid;
+    unsigned int count, dropped;
+    int depth;
+    unsigned int stack[PROF_MAX_DEPTH];
+    ProfEvent events[PROF_MAX_EVENTS];
+} ProfThread;
+
+typedef struct {
+    const char *name;
+    bool gpu;
+    unsigned int count;         /* samples ever added */
+    float samples[PROF_SAMPLES];    /* ms, ring */
+} ProfScope;
+
+typedef struct {
+    GLuint queries[PROF_GPU_SCOPES * 2];
+    const char *names[PROF_GPU_SCOPES];
+    unsigned int count;
+    int depth;
+    unsigned int stack[PROF_MAX_DEPTH];
+    int64_t offset;             /* CPU ns minus GPU ns when the frame began */
+    bool pending;
+} ProfGpuFrame;
+
+typedef struct {
+    const char *name;
+    bool gpu;
+    int tid;
+    uint64_t start, dur;
+} ProfTraceEvent;
+
+static bool enabled;
+static pthread_mutex_t threads_lock = PTHREAD_MUTEX_INITIALIZER;
+static ProfThread *threads[PROF_MAX_THREADS];
+static atomic_int thread_count;
+static _Thread_local ProfThread *self;
+
+static ProfScope scopes[PROF_MAX_SCOPES];
+static unsigned int scope_count;
+
+static ProfGpuFrame gpu[PROF_GPU_SLOTS];
+static unsigned long gpu_frame;
+static bool gpu_ready;
+
+static FILE *trace;
+static ProfTraceEvent *trace_events;
+static unsigned int trace_count;
+static uint64_t trace_origin;
+
+static uint64_t now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000ull + t.tv_nsec;
+}
+
+void prof_init(void)
+{
+    /* Off by default: every scope costs clock reads and GL queries. */
+    const char *env = getenv("PROFILE"), *path = getenv("PROFILE_TRACE");
+    enabled = (env && atoi(env)) || path;
+    if (!enabled)
+        return;
+
+    if (path) {
+        trace = fopen(path, "w");
+        trace_events = malloc(sizeof(*trace_events) * PROF_TRACE_MAX);
+        if (!trace || !trace_events) {
+            log_error("profile: cannot trace to %s", path);
+            if (trace)
+                fclose(trace);
+            free(trace_events);
+            trace = NULL;
+            trace_events = NULL;
+        }
+    }
+    trace_origin = now_ns();
+    log_info("profile: enabled%s%s", trace ? ", tracing to " : "", trace ? path : "");
+}
+
+static ProfThread *thread_buffer(void)
+{
+    if (self)
+        return self;
+
+    int id = atomic_fetch_add(&thread_count, 1);
+    if (id >= PROF_MAX_THREADS) {
+        log_error("profile: more than %d threads", PROF_MAX_THREADS);
+        exit(1);
+    }
+    self = calloc(1, sizeof(*self));
+    if (!self) {
+        log_fatal("profile: out of memory");
+        exit(1);
+    }
+    self->tid = id;
+    pthread_mutex_lock(&threads_lock);
+    threads[id] = self;
+    pthread_mutex_unlock(&threads_lock);
+    return self;
+}
+
+void prof_begin(const char *name)
+{
+    if (!enabled)
+        return;
+    ProfThread *t = thread_buffer();
+
+    if (t->count == PROF_MAX_EVENTS || t->depth == PROF_MAX_DEPTH) {
+        t->dropped++;
+        t->stack[t->depth < PROF_MAX_DEPTH ? t->depth : PROF_MAX_DEPTH - 1] = UINT32_MAX;
+        t->depth += t->depth < PROF_MAX_DEPTH;
+        return;
+    }
+    t->stack[t->depth++] = t->count;
+    t->events[t->count++] = (ProfEvent) {name, now_ns(), 0};
+}
+
+void prof_end(void)
+{
+    if (!enabled)
+        return;
+    ProfThread *t = thread_buffer();
+    if (!t->depth)
+        return;
+
+    unsigned int i = t->stack[--t->depth];
+    if (i != UINT32_MAX)
+        t->events[i].end = now_ns();
+}
+
+void prof_gpu_begin(const char *name)
+{
+    if (!enabled || !gpu_ready)
+        return;
+    ProfGpuFrame *f = &gpu[gpu_frame % PROF_GPU_SLOTS];
+
+    if (f->count == PROF_GPU_SCOPES || f->depth == PROF_MAX_DEPTH) {
+        f->stack[f->depth < PROF_MAX_DEPTH ? f->depth : PROF_MAX_DEPTH - 1] = UINT32_MAX;
+        f->depth += f->depth < PROF_MAX_DEPTH;
+        return;
+    }
+    f->stack[f->depth++] = f->count;
+    f->names[f->count] = name;
+    glQueryCounter(f->queries[f->count * 2], GL_TIMESTAMP);
+    f->count++;
+}
+
+void prof_gpu_end(void)
+{
+    if (!enabled || !gpu_ready)
+        return;
+    ProfGpuFrame *f = &gpu[gpu_frame % PROF_GPU_SLOTS];
+    if (!f->depth)
+        return;
+
+    unsigned int i = f->stack[--f->depth];
+    if (i != UINT32_MAX)
+        glQueryCounter(f->queries[i * 2 + 1], GL_TIMESTAMP);
+}
+
+static void scope_add(const char *name, bool is_gpu, int tid, uint64_t start, uint64_t end)
+{
+    ProfScope *s = NULL;
+    for (unsigned int i = 0; i < scope_count; i++) {
+        if (scopes[i].gpu == is_gpu && (scopes[i].name == name || !strcmp(scopes[i].name, name))) {
+            s = &scopes[i];
+            break;
+        }
+    }
+    if (!s && scope_count < PROF_MAX_SCOPES)
+        s = &scopes[scope_count++];
+    if (s) {
+        s->name = name;
+        s->gpu = is_gpu;
+        s->samples[s->count++ % PROF_SAMPLES] = (end - start) * 1e-6f;
+    }
+
+    if (trace_events && trace_count < PROF_TRACE_MAX && start >= trace_origin)
+        trace_events[trace_count++] = (ProfTraceEvent) {name, is_gpu, tid, start - trace_origin, end - start};
+}
+
+/* GL thread, once per frame before any GPU scope. Lazily creates the query
+ * pool and pairs the GPU clock with the CPU clock for this frame. */
+void prof_frame_begin(void)
+{
+    if (!enabled)
+        return;
+    if (!gpu_ready) {
+        for (int i = 0; i < PROF_GPU_SLOTS; i++)
+            glGenQueries(PROF_GPU_SCOPES * 2, gpu[i].queries);
+        gpu_ready = true;
+    }
+
+    ProfGpuFrame *f = &gpu[gpu_frame % PROF_GPU_SLOTS];
+    GLint64 gpu_now;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    f->offset = (int64_t) now_ns() - gpu_now;
+    f->count = 0;
+    f->depth = 0;
+}
+
+/* Reads back the oldest GPU frame if its queries are done (skipping it
+ * otherwise rather than waiting). */
+static void collect_gpu(ProfGpuFrame *f)
+{
+    if (!f->pending || !f->count)
+        return;
+
+    GLint available = 0;
+    glGetQueryObjectiv(f->queries[f->count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return;
+
+    for (unsigned int i = 0; i < f->count; i++) {
+        GLuint64 begin, end;
+        glGetQueryObjectui64v(f->queries[i * 2], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(f->queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+        if (end >= begin)
+            scope_add(f->names[i], true, -1, begin + f->offset, end + f->offset);
+    }
+    f->pending = false;
+}
+
+/* GL thread, after the frame's jobs have all finished: moves every
+ * thread's closed scopes into the statistics and trace. */
+void prof_frame_end(void)
+{
+    if (!enabled)
+        return;
+
+    int n = atomic_load(&thread_count);
+    for (int i = 0; i < n && i < PROF_MAX_THREADS; i++) {
+        pthread_mutex_lock(&threads_lock);
+        ProfThread *t = threads[i];
+        pthread_mutex_unlock(&threads_lock);
+        if (!t || t->depth)
+            continue;
+        for (unsigned int e = 0; e < t->count; e++)
+            if (t->events[e].end)
+                scope_add(t->events[e].name, false, t->tid, t->events[e].start, t->events[e].end);
+        t->count = 0;
+    }
+
+    if (gpu_ready) {
+        gpu[gpu_frame % PROF_GPU_SLOTS].pending = true;
+        gpu_frame++;
+        collect_gpu(&gpu[gpu_frame % PROF_GPU_SLOTS]);
+    }
+}
+
+static int float_cmp(const void *a, const void *b)
+{
+    float fa = *(const float *) a, fb = *(const float *) b;
+    return fa < fb ? -1 : fa > fb;
+}
+
+void prof_report(void)
+{
+    if (!enabled)
+        return;
+
+    for (unsigned int i = 0; i < scope_count; i++) {
+        ProfScope *s = &scopes[i];
+        unsigned int n = s->count < PROF_SAMPLES ? s->count : PROF_SAMPLES;
+        if (!n)
+            continue;
+
+        float sorted[PROF_SAMPLES], sum = 0.0f;
+        memcpy(sorted, s->samples, sizeof(float) * n);
+        qsort(sorted, n, sizeof(float), float_cmp);
+        for (unsigned int j = 0; j < n; j++)
+            sum += sorted[j];
+        log_info("profile: %-10s %s min %7.3f  avg %7.3f  p99 %7.3f ms", s->name, s->gpu ? "gpu" : "cpu",
+                 sorted[0], sum / n, sorted[(n * 99) / 100]);
+    }
+}
+
+static void write_trace(void)
+{
+    fprintf(trace, "{\"traceEvents\":[\n");
+    fprintf(trace, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1000,\"args\":{\"name\":\"GPU\"}}%s\n",
+            trace_count ? "," : "");
+    for (unsigned int i = 0; i < trace_count; i++) {
+        ProfTraceEvent *e = &trace_events[i];
+        fprintf(trace, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                e->name, e->gpu ? "gpu" : "cpu", e->gpu ? 1000 : e->tid,
+                e->start * 1e-3, e->dur * 1e-3, i + 1 < trace_count ? "," : "");
+    }
+    fprintf(trace, "],\n\"displayTimeUnit\":\"ms\"}\n");
+}
+
+/* GL thread, with the context still current. */
+void prof_shutdown(void)
+{
+    if (!enabled)
+        return;
+
+    if (trace) {
+        write_trace();
+        fclose(trace);
+        log_info("profile: wrote %u trace events", trace_count);
+        trace = NULL;
+    }
+    free(trace_events);
+    trace_events = NULL;
+
+    if (gpu_ready)
+        for (int i = 0; i < PROF_GPU_SLOTS; i++)
+            glDeleteQueries(PROF_GPU_SCOPES * 2, gpu[i].queries);
+    gpu_ready = false;
+
+    for (int i = 0; i < atomic_load(&thread_count) && i < PROF_MAX_THREADS; i++) {
+        free(threads[i]);
+        threads[i] = NULL;
+    }
+    atomic_store(&thread_count, 0);
+    enabled = false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#define PROF_MAX_THREADS 65         /* job workers plus the render thread */
+#define PROF_MAX_EVENTS 4096        /* per thread per frame */
+#define PROF_MAX_DEPTH 16
+#define PROF_MAX_SCOPES 64          /* distinct names tracked for statistics */
+#define PROF_SAMPLES 256            /* rolling window per scope */
+#define PROF_GPU_SLOTS 3            /* frames of queries in flight */
+#define PROF_GPU_SCOPES 64          /* per frame */
+#define PROF_TRACE_MAX (1 << 20)    /* events kept for the trace file */
+
+/* Hierarchical CPU and GPU frame profiler.
+ *
+ * CPU scopes nest per thread and may be used from the render thread and
+ * job workers; their buffers are collected in prof_frame_end(), after the
+ * frame's jobs have finished. GPU scopes are GL_TIMESTAMP query pairs,
+ * which nest freely (GL_TIME_ELAPSED queries can't), read back
+ * PROF_GPU_SLOTS frames later so results never stall the pipeline.
+ *
+ * Everything is a no-op unless $PROFILE=1 or $PROFILE_TRACE is set.
+ * Rolling min/avg/p99 per scope go to the log from prof_report(); setting
+ * $PROFILE_TRACE=file also writes a Chrome trace-event JSON file (open it
+ * in chrome://tracing or Perfetto) at prof_shutdown(). Scope names must be
+ * string literals. */
+void prof_init(void);
+void prof_shutdown(void);
+void prof_begin(const char *name);
+void prof_end(void);
+void prof_gpu_begin(const char *name);
+void prof_gpu_end(void);
+void prof_frame_begin(void);
+void prof_frame_end(void);
+void prof_report(void);
@@ -0,0 +1,62 @@
+#include "redraw.h"
+#include "log.h"
+#include <stdlib.h>
+
+void redraw_init(Redraw *r, int on_demand)
+{
+    if (on_demand < 0) {
+        const char *env = getenv("ON_DEMAND");
+        on_demand = env && atoi(env);
+    }
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->cond, NULL);
+    r->damage = DAMAGE_ALL;
+    r->on_demand = on_demand;
+    r->drawn = r->idle = 0;
+    log_info("redraw: %s", on_demand ? "on demand" : "continuous");
+}
+
+void redraw_destroy(Redraw *r)
+{
+    pthread_cond_destroy(&r->cond);
+    pthread_mutex_destroy(&r->lock);
+}
+
+void redraw_damage(Redraw *r, unsigned int flags)
+{
+    if (!flags)
+        return;
+    pthread_mutex_lock(&r->lock);
+    r->damage |= flags;
+    pthread_mutex_unlock(&r->lock);
+    pthread_cond_signal(&r->cond);
+}
+
+/* Render thread: returns and clears the pending damage, blocking while
+ * there is none in on-demand mode. No new frame means the window system
+ * keeps showing the last presented image, so an idle renderer costs
+ * nothing. Returns REDRAW_WAKE alone when woken only for shutdown. */
+unsigned int redraw_wait(Redraw *r)
+{
+    if (!r->on_demand) {
+        pthread_mutex_lock(&r->lock);
+        unsigned int wake = r->damage & REDRAW_WAKE;
+        r->damage = 0;
+        pthread_mutex_unlock(&r->lock);
+        r->drawn++;
+        return DAMAGE_ALL | wake;
+    }
+
+    pthread_mutex_lock(&r->lock);
+    if (!r->damage)
+        r->idle++;
+    while (!r->damage)
+        pthread_cond_wait(&r->cond, &r->lock);
+    unsigned int damage = r->damage;
+    r->damage = 0;
+    pthread_mutex_unlock(&r->lock);
+
+    if (damage & DAMAGE_ALL)
+        r->drawn++;
+    return damage;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <pthread.h>
+#include <stdbool.h>
+
+/* Reasons to draw a new frame. */
+enum {
+    DAMAGE_INPUT = 1u << 0,
+    DAMAGE_CAMERA = 1u << 1,
+    DAMAGE_ANIMATION = 1u << 2,
+    DAMAGE_RESOURCES = 1u << 3,
+    DAMAGE_RESIZE = 1u << 4,
+    DAMAGE_EXPOSE = 1u << 5,
+    DAMAGE_ALL = (1u << 6) - 1,
+    REDRAW_WAKE = 1u << 31      /* shutdown: wake the renderer without drawing */
+};
+
+#define REDRAW_IDLE_TIMEOUT 1.0     /* seconds the simulation sleeps when idle */
+
+/* Damage collected from any thread for the render thread. In continuous
+ * mode every frame counts as fully damaged; in on-demand mode the render
+ * thread sleeps until someone raises a flag. */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned int damage;
+    bool on_demand;
+    unsigned long drawn, idle;      /* frames drawn, sleeps for lack of damage */
+} Redraw;
+
+/* on_demand < 0 reads $ON_DEMAND. */
+void redraw_init(Redraw *r, int on_demand);
+void redraw_destroy(Redraw *r);
+void redraw_damage(Redraw *r, unsigned int flags);
+unsigned int redraw_wait(Redraw *r);
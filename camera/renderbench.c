@@ -0,0 +1,505 @@
+#include "gl_shader.h"
+#include "window.h"
+#include "mesh.h"
+#include "cmdbuf.h"
+#include "gl_debug.h"
+#include "stream.h"
+#include "job.h"
+#include "mathbatch.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define BENCH_WIDTH 1280
+#define BENCH_HEIGHT 720
+#define BENCH_FRAMES 300
+#define BENCH_WARMUP 10
+#define BENCH_THRESHOLD 0.10        /* relative slowdown flagged as a regression */
+#define BENCH_NOISE_MS 0.02         /* absolute differences below this are ignored */
+#define BENCH_DRAW_BINDING 0        /* uniform buffer binding of the Draw block */
+#define P_GLUMAT(m) (&m[0][0])
+
+typedef enum {
+    PATTERN_SORTED,         /* keys by program and mesh, the renderer's order */
+    PATTERN_INTERLEAVED     /* submission order, every draw changes state */
+} Pattern;
+
+/* How each draw gets its matrix. */
+typedef enum {
+    UNIFORMS_CALLS,         /* glUniformMatrix4fv per draw */
+    UNIFORMS_BUFFER         /* one stream ring upload per frame, a range bound per draw */
+} UniformPath;
+
+typedef struct {
+    const char *name;
+    unsigned int meshes, instances, programs, vertices;
+    Pattern pattern;
+    UniformPath uniforms;
+} SceneSpec;
+
+/* Vertex counts vary per mesh from vertices / 4 up to vertices. */
+static const SceneSpec presets[] = {
+    {"baseline", 8, 256, 2, 1024, PATTERN_SORTED, UNIFORMS_CALLS},
+    {"draw-heavy", 16, 4096, 4, 64, PATTERN_SORTED, UNIFORMS_CALLS},
+    {"draw-heavy-ubo", 16, 4096, 4, 64, PATTERN_SORTED, UNIFORMS_BUFFER},
+    {"state-thrash", 16, 4096, 8, 64, PATTERN_INTERLEAVED, UNIFORMS_CALLS},
+    {"state-thrash-ubo", 16, 4096, 8, 64, PATTERN_INTERLEAVED, UNIFORMS_BUFFER},
+    {"vertex-heavy", 4, 16, 1, 65536, PATTERN_SORTED, UNIFORMS_CALLS},
+};
+
+typedef struct {
+    const char *name;
+    unsigned int frames;
+    double cpu_ms, gl_calls, draws, skipped;
+    double frame_min, frame_mean, frame_p50, frame_p90, frame_p99, frame_max;
+} SceneResult;
+
+typedef struct {
+    GLuint mesh[4];
+} BenchMesh;
+
+static const char *vert_s = GLSL(330,
+    layout (location = 0) in vec3 pos;
+    uniform mat4 mvp;
+    out vec3 vpos;
+    void main() {
+        gl_Position = mvp * vec4(pos, 1.0);
+        vpos = pos;
+    }
+);
+
+/* The same with the matrix in a uniform block, bound per draw. */
+static const char *vert_block_s = GLSL(330,
+    layout (location = 0) in vec3 pos;
+    layout (std140) uniform Draw {
+        mat4 mvp;
+    };
+    out vec3 vpos;
+    void main() {
+        gl_Position = mvp * vec4(pos, 1.0);
+        vpos = pos;
+    }
+);
+
+/* Each program gets its own tint so the driver can't share binaries. */
+static const char *frag_fmt =
+    "#version 330\n"
+    "in vec3 vpos;\n"
+    "out vec4 color;\n"
+    "void main() {\n"
+    "    color = vec4(clamp(vpos * 0.5 + 0.5, 0.0, 1.0) * vec3(%f, %f, %f), 1.0);\n"
+    "}\n";
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static double thread_cpu()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* Every GL call made so far, through the loader's call counters. */
+static unsigned long gl_calls()
+{
+    unsigned long total = 0;
+    for (unsigned int i = 0; i < gl_loader_count; i++)
+        total += gl_counters[i];
+    return total;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* A side x side grid in the xy plane with a little relief. */
+static void grid_mesh(BenchMesh *m, unsigned int vertices)
+{
+    unsigned int side = (unsigned int) sqrtf((float) vertices);
+    if (side < 2)
+        side = 2;
+    unsigned int len_vertices = side * side * 3;
+    unsigned int len_indices = (side - 1) * (side - 1) * 6;
+    GLfloat *verts = malloc(sizeof(GLfloat) * len_vertices);
+    unsigned int *inds = malloc(sizeof(unsigned int) * len_indices);
+
+    for (unsigned int y = 0, v = 0; y < side; y++) {
+        for (unsigned int x = 0; x < side; x++) {
+            float u = (float) x / (side - 1) * 2.0f - 1.0f;
+            float w = (float) y / (side - 1) * 2.0f - 1.0f;
+            verts[v++] = u;
+            verts[v++] = w;
+            verts[v++] = 0.1f * sinf(u * 6.0f) * cosf(w * 6.0f);
+        }
+    }
+    for (unsigned int y = 0, i = 0; y + 1 < side; y++) {
+        for (unsigned int x = 0; x + 1 < side; x++) {
+            unsigned int a = y * side + x;
+            inds[i++] = a; inds[i++] = a + 1; inds[i++] = a + side;
+            inds[i++] = a + 1; inds[i++] = a + side + 1; inds[i++] = a + side;
+        }
+    }
+
+    create_mesh(m->mesh, verts, inds, len_vertices, len_indices);
+    free(verts);
+    free(inds);
+}
+
+static void percentiles(SceneResult *r, double *frame_ms, unsigned int count)
+{
+    double sum = 0.0;
+    for (unsigned int i = 0; i < count; i++)
+        sum += frame_ms[i];
+    qsort(frame_ms, count, sizeof(double), cmp_double);
+    r->frame_min = frame_ms[0];
+    r->frame_max = frame_ms[count - 1];
+    r->frame_mean = sum / count;
+    r->frame_p50 = frame_ms[count * 50 / 100];
+    r->frame_p90 = frame_ms[count * 90 / 100];
+    r->frame_p99 = frame_ms[count * 99 / 100];
+}
+
+static void run_scene(struct Window *w, const SceneSpec *s, unsigned int frames, SceneResult *r)
+{
+    BenchMesh *meshes = calloc(s->meshes, sizeof(BenchMesh));
+    GLuint *programs = calloc(s->programs, sizeof(GLuint));
+    GLint *uniform_mvp = calloc(s->programs, sizeof(GLint));
+    vec3 *pos = malloc(sizeof(vec3) * s->instances);
+    versor *rot = aligned_alloc(16, sizeof(versor) * s->instances);
+    vec3 *scale = malloc(sizeof(vec3) * s->instances);
+    mat4 *model = aligned_alloc(32, sizeof(mat4) * s->instances);
+    double *frame_ms = malloc(sizeof(double) * frames);
+    CmdQueue queue;
+    StreamBuffer stream;
+    mat4 proj, view, vp;
+    bool block = s->uniforms == UNIFORMS_BUFFER;
+
+    for (unsigned int i = 0; i < s->meshes; i++)
+        grid_mesh(&meshes[i], s->vertices / 4 + s->vertices * 3 / 4 * (i % 4) / 3);
+
+    for (unsigned int i = 0; i < s->programs; i++) {
+        char frag[512];
+        snprintf(frag, sizeof(frag), frag_fmt, 1.0f - 0.5f * i / s->programs, 0.5f + 0.5f * i / s->programs, 1.0f);
+        programs[i] = gl_create_program_from_str(block ? vert_block_s : vert_s, frag);
+        if (!programs[i] || (block && !gl_uniform_block_binding(programs[i], "Draw", BENCH_DRAW_BINDING))) {
+            log_fatal("renderbench: %s: program %u failed to build", s->name, i);
+            exit(1);
+        }
+        uniform_mvp[i] = block ? -1 : glGetUniformLocation(programs[i], "mvp");
+    }
+
+    /* Instances on a square grid filling the view. */
+    unsigned int side = (unsigned int) ceilf(sqrtf((float) s->instances));
+    for (unsigned int i = 0; i < s->instances; i++) {
+        float x = (float) (i % side) / side * 2.0f - 1.0f;
+        float y = (float) (i / side) / side * 2.0f - 1.0f;
+        glm_vec3_copy((vec3) {x * side, y * side, 0.0f}, pos[i]);
+        scale[i][0] = scale[i][1] = scale[i][2] = 0.45f;
+    }
+    glm_perspective(glm_rad(45.0f), (float) BENCH_WIDTH / BENCH_HEIGHT, 0.1f, side * 4.0f, proj);
+    glm_lookat((vec3) {0.0f, 0.0f, side * 1.3f}, (vec3) {0.0f, 0.0f, 0.0f}, (vec3) {0.0f, 1.0f, 0.0f}, view);
+    glm_mat4_mul(proj, view, vp);
+
+    cmd_queue_init(&queue);
+    /* Every draw's matrix starts on a uniform offset boundary. */
+    GLint uniform_align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_align);
+    size_t stride = (sizeof(mat4) + uniform_align - 1) / uniform_align * uniform_align;
+    if (block)
+        stream_init(&stream, stride * s->instances * STREAM_REGIONS);
+    memset(r, 0, sizeof(*r));
+    r->name = s->name;
+    r->frames = frames;
+
+    double cpu_total = 0.0;
+    unsigned long calls = 0, draws = 0, skipped = 0;
+    for (unsigned int f = 0; f < BENCH_WARMUP + frames; f++) {
+        double t0 = now(), c0 = thread_cpu();
+        unsigned long calls0 = gl_calls(), skipped0 = queue.skipped;
+
+        /* Every instance spins, so the transforms are rebuilt each frame. */
+        for (unsigned int i = 0; i < s->instances; i++)
+            glm_quatv(rot[i], f * 0.02f + i, (vec3) {0.0f, 0.0f, 1.0f});
+        batch_trs(pos, rot, scale, model, s->instances);
+        batch_mat4_mul(vp, (const mat4 *) model, model, s->instances);
+
+        GLintptr base = 0;
+        unsigned char *block_data = NULL;
+        if (block) {
+            stream_begin_frame(&stream);
+            block_data = stream_alloc(&stream, stride * s->instances, stream.uniform_align, &base);
+            if (!block_data) {
+                log_fatal("renderbench: %s: stream ring too small", s->name);
+                exit(1);
+            }
+            for (unsigned int i = 0; i < s->instances; i++)
+                memcpy(block_data + stride * i, model[i], sizeof(mat4));
+            stream_flush(&stream);
+        }
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        CmdBuffer *b = cmd_thread_buffer(&queue);
+        for (unsigned int i = 0; i < s->instances; i++) {
+            unsigned int p = i % s->programs;
+            BenchMesh *m = &meshes[i % s->meshes];
+            uint64_t key = s->pattern == PATTERN_SORTED ? CMD_KEY(programs[p], m->mesh[VAO], i) : CMD_KEY(0, 0, i);
+
+            cmd_begin(b, key);
+            cmd_use_program(b, programs[p]);
+            if (block)
+                cmd_bind_uniforms(b, BENCH_DRAW_BINDING, stream.buffer, base + stride * i, sizeof(mat4));
+            else
+                cmd_uniform_mat4(b, uniform_mvp[p], P_GLUMAT(model[i]));
+            cmd_bind_mesh(b, m->mesh[VAO]);
+            cmd_draw_elements(b, m->mesh[INDEX_COUNT], 0);
+            cmd_end(b);
+        }
+        cmd_queue_submit(&queue);
+        glBindVertexArray(0);
+        glUseProgram(0);
+        if (block)
+            stream_end_frame(&stream);
+        window_swap(w);
+
+        if (f < BENCH_WARMUP)
+            continue;
+        frame_ms[f - BENCH_WARMUP] = (now() - t0) * 1e3;
+        cpu_total += thread_cpu() - c0;
+        calls += gl_calls() - calls0;
+        skipped += queue.skipped - skipped0;
+        draws += s->instances;
+    }
+
+    r->cpu_ms = cpu_total * 1e3 / frames;
+    r->gl_calls = (double) calls / frames;
+    r->draws = (double) draws / frames;
+    r->skipped = (double) skipped / frames;
+    percentiles(r, frame_ms, frames);
+    log_info("renderbench: %-12s %5.2f ms cpu, %5.2f ms p50, %6.2f ms p99, %.0f gl calls/frame",
+             s->name, r->cpu_ms, r->frame_p50, r->frame_p99, r->gl_calls);
+
+    cmd_queue_destroy(&queue);
+    if (block)
+        stream_destroy(&stream);
+    for (unsigned int i = 0; i < s->programs; i++)
+        glDeleteProgram(programs[i]);
+    for (unsigned int i = 0; i < s->meshes; i++)
+        clear_mesh(meshes[i].mesh);
+    free(meshes);
+    free(programs);
+    free(uniform_mvp);
+    free(pos);
+    free(rot);
+    free(scale);
+    free(model);
+    free(frame_ms);
+}
+
+static void write_json(FILE *out, const char *renderer, const SceneResult *results, unsigned int count)
+{
+    fprintf(out, "{\n  \"renderer\": \"%s\",\n  \"math_isa\": \"%s\",\n  \"scenes\": [\n",
+            renderer, mathbatch_isa_name(mathbatch_isa()));
+    for (unsigned int i = 0; i < count; i++) {
+        const SceneResult *r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"frames\": %u, \"cpu_ms\": %.4f, \"gl_calls\": %.1f, "
+                     "\"draws\": %.1f, \"skipped\": %.1f, \"frame_ms\": {\"min\": %.4f, \"mean\": %.4f, "
+                     "\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}}%s\n",
+                r->name, r->frames, r->cpu_ms, r->gl_calls, r->draws, r->skipped,
+                r->frame_min, r->frame_mean, r->frame_p50, r->frame_p90, r->frame_p99, r->frame_max,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+static char *read_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *text = malloc(size + 1);
+    if (fread(text, 1, size, f) != (size_t) size) {
+        free(text);
+        fclose(f);
+        return NULL;
+    }
+    text[size] = '\0';
+    fclose(f);
+    return text;
+}
+
+/* Looks up "key": number between begin and end, as written by write_json(). */
+static bool json_number(const char *begin, const char *end, const char *key, double *value)
+{
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *p = strstr(begin, pattern);
+    if (!p || p >= end)
+        return false;
+    *value = strtod(p + strlen(pattern), NULL);
+    return true;
+}
+
+static int check_metric(const char *scene, const char *metric, double current, double baseline, double threshold)
+{
+    if (current <= baseline * (1.0 + threshold) || current - baseline < BENCH_NOISE_MS)
+        return 0;
+    log_warn("renderbench: %s %s regressed: %.4g -> %.4g (+%.1f%%)",
+             scene, metric, baseline, current, (current / baseline - 1.0) * 100.0);
+    return 1;
+}
+
+/* Compares every scene also present in the baseline file. Returns the number
+ * of regressed metrics, or -1 if the baseline can't be read. */
+static int compare_baseline(const char *path, const SceneResult *results, unsigned int count, double threshold)
+{
+    char *text = read_file(path);
+    if (!text) {
+        log_error("renderbench: can't read baseline %s", path);
+        return -1;
+    }
+
+    int regressions = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        const SceneResult *r = &results[i];
+        char pattern[128];
+        snprintf(pattern, sizeof(pattern), "\"name\": \"%s\"", r->name);
+        const char *begin = strstr(text, pattern);
+        if (!begin) {
+            log_info("renderbench: %s not in baseline, skipped", r->name);
+            continue;
+        }
+        const char *end = strstr(begin + 1, "\"name\":");
+        if (!end)
+            end = text + strlen(text);
+
+        double cpu, calls, p50, p99;
+        if (!json_number(begin, end, "cpu_ms", &cpu) || !json_number(begin, end, "gl_calls", &calls)
+            || !json_number(begin, end, "p50", &p50) || !json_number(begin, end, "p99", &p99)) {
+            log_error("renderbench: %s: malformed baseline entry", r->name);
+            regressions++;
+            continue;
+        }
+        /* Call counts are deterministic, so any increase counts. */
+        regressions += check_metric(r->name, "gl_calls", r->gl_calls, calls, 0.0);
+        regressions += check_metric(r->name, "cpu_ms", r->cpu_ms, cpu, threshold);
+        regressions += check_metric(r->name, "frame p50", r->frame_p50, p50, threshold);
+        regressions += check_metric(r->name, "frame p99", r->frame_p99, p99, threshold);
+    }
+    free(text);
+    return regressions;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: renderbench [--scene name] [--frames n] [--json file] [--baseline file] [--threshold fraction]\n"
+                    "       renderbench --custom meshes instances programs vertices sorted|interleaved\n"
+                    "scenes:");
+    for (unsigned int i = 0; i < sizeof(presets) / sizeof(presets[0]); i++)
+        fprintf(stderr, " %s", presets[i].name);
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+/* Renders synthetic scenes offscreen and reports per-frame CPU time, GL
+ * calls and frame-time percentiles as JSON. With --baseline, exits 1 when
+ * a metric is worse than the stored run by more than the threshold. */
+int main(int argc, char **argv)
+{
+    const unsigned int preset_count = sizeof(presets) / sizeof(presets[0]);
+    SceneSpec scenes[sizeof(presets) / sizeof(presets[0])];
+    unsigned int scene_count = 0;
+    unsigned int frames = BENCH_FRAMES;
+    const char *json = NULL, *baseline = NULL;
+    double threshold = BENCH_THRESHOLD;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--scene") && i + 1 < argc) {
+            const char *name = argv[++i];
+            unsigned int p = 0;
+            while (p < preset_count && strcmp(presets[p].name, name))
+                p++;
+            if (p == preset_count || scene_count == preset_count)
+                usage();
+            scenes[scene_count++] = presets[p];
+        } else if (!strcmp(argv[i], "--custom") && i + 5 < argc && scene_count < preset_count) {
+            SceneSpec s = {"custom", 0, 0, 0, 0, PATTERN_SORTED, UNIFORMS_CALLS};
+            s.meshes = strtoul(argv[++i], NULL, 10);
+            s.instances = strtoul(argv[++i], NULL, 10);
+            s.programs = strtoul(argv[++i], NULL, 10);
+            s.vertices = strtoul(argv[++i], NULL, 10);
+            s.pattern = !strcmp(argv[++i], "interleaved") ? PATTERN_INTERLEAVED : PATTERN_SORTED;
+            if (!s.meshes || !s.instances || !s.programs || !s.vertices)
+                usage();
+            scenes[scene_count++] = s;
+        } else if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+            json = argv[++i];
+        } else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) {
+            baseline = argv[++i];
+        } else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            usage();
+        }
+    }
+    if (!frames)
+        usage();
+    if (!scene_count) {
+        memcpy(scenes, presets, sizeof(presets));
+        scene_count = preset_count;
+    }
+
+    /* Vsync and the frame cap don't apply offscreen; one thread records
+     * so runs are repeatable. */
+    struct Window *w = init_headless_window(BENCH_WIDTH, BENCH_HEIGHT, 0);
+    gl_counters_hook();
+    mathbatch_init();
+    job_init(0);
+    glClearColor(0.0f, 0.0f, 0.1f, 1.0f);
+
+    SceneResult results[sizeof(presets) / sizeof(presets[0])];
+    for (unsigned int i = 0; i < scene_count; i++)
+        run_scene(w, &scenes[i], frames, &results[i]);
+
+    const char *renderer = (const char *) glGetString(GL_RENDERER);
+    if (json) {
+        FILE *out = fopen(json, "w");
+        if (!out) {
+            log_error("renderbench: can't write %s", json);
+            return 1;
+        }
+        write_json(out, renderer, results, scene_count);
+        fclose(out);
+    } else {
+        write_json(stdout, renderer, results, scene_count);
+    }
+
+    int status = 0;
+    if (baseline) {
+        int regressions = compare_baseline(baseline, results, scene_count, threshold);
+        if (regressions)
+            status = 1;
+        if (regressions > 0)
+            log_warn("renderbench: %d regression(s) against %s", regressions, baseline);
+        else if (!regressions)
+            log_info("renderbench: no regressions against %s", baseline);
+    }
+
+    job_shutdown();
+    destroy_window(w);
+    return status;
+}
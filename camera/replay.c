@@ -0,0 +1,238 @@
+#include "replay.h"
+#include "capture.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t *keys, *values;
+    size_t count, capacity;     /* capacity is a power of two */
+} NameMap;
+
+static const unsigned char *base, *pos, *end;
+static NameMap maps[REPLAY_NAMESPACE_COUNT];
+static GLuint *scratch;
+static GLsizei scratch_capacity;
+static unsigned char out[REPLAY_OUT_SLOTS][REPLAY_OUT_SIZE];
+static GLuint current_program;
+
+static void truncated(void)
+{
+    log_fatal("replay: capture truncated at byte %zu", (size_t) (pos - base));
+    exit(1);
+}
+
+static const unsigned char *take(size_t n)
+{
+    if ((size_t) (end - pos) < n)
+        truncated();
+    const unsigned char *p = pos;
+    pos += n;
+    return p;
+}
+
+static void align4(void)
+{
+    take(-(uintptr_t) (pos - base) & 3);
+}
+
+/* data must stay valid while replaying; payloads point into it. */
+void replay_open(const unsigned char *data, size_t size)
+{
+    base = pos = data;
+    end = data + size;
+}
+
+size_t replay_tell(void)
+{
+    return pos - base;
+}
+
+void replay_seek(size_t offset)
+{
+    pos = base + offset;
+}
+
+uint16_t replay_call_id(void)
+{
+    uint16_t v;
+    memcpy(&v, take(sizeof(v)), sizeof(v));
+    return v;
+}
+
+uint32_t replay_u32(void)
+{
+    uint32_t v;
+    memcpy(&v, take(sizeof(v)), sizeof(v));
+    return v;
+}
+
+uint64_t replay_u64(void)
+{
+    uint64_t v;
+    memcpy(&v, take(sizeof(v)), sizeof(v));
+    return v;
+}
+
+float replay_f32(void)
+{
+    float v;
+    memcpy(&v, take(sizeof(v)), sizeof(v));
+    return v;
+}
+
+static const unsigned char *payload(uint64_t *size)
+{
+    *size = replay_u64();
+    if (*size == CAPTURE_NULL)
+        return NULL;
+    align4();
+    const unsigned char *p = take(*size);
+    align4();
+    return p;
+}
+
+const void *replay_bytes(void)
+{
+    uint64_t size;
+    return payload(&size);
+}
+
+/* Strings go to GL as they are, so a payload without its terminator
+ * would have the driver read past the capture. */
+const char *replay_string(void)
+{
+    uint64_t size;
+    const unsigned char *p = payload(&size);
+    if (p && (!size || p[size - 1])) {
+        log_fatal("replay: unterminated string ending at byte %zu", (size_t) (p + size - base));
+        exit(1);
+    }
+    return (const char *) p;
+}
+
+static size_t slot(const NameMap *m, uint64_t key)
+{
+    size_t i = (key * UINT64_C(0x9e3779b97f4a7c15)) >> 32 & (m->capacity - 1);
+    while (m->keys[i] != key && m->keys[i] != UINT64_MAX)
+        i = (i + 1) & (m->capacity - 1);
+    return i;
+}
+
+static void map_grow(NameMap *m)
+{
+    NameMap old = *m;
+    m->capacity = old.capacity ? old.capacity * 2 : 256;
+    m->keys = malloc(sizeof(uint64_t) * m->capacity);
+    m->values = malloc(sizeof(uint64_t) * m->capacity);
+    if (!m->keys || !m->values) {
+        log_fatal("replay: out of memory growing a name map");
+        exit(1);
+    }
+    memset(m->keys, 0xff, sizeof(uint64_t) * m->capacity);
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.keys[i] == UINT64_MAX)
+            continue;
+        size_t s = slot(m, old.keys[i]);
+        m->keys[s] = old.keys[i];
+        m->values[s] = old.values[i];
+    }
+    free(old.keys);
+    free(old.values);
+}
+
+/* Name 0 is the default object in every namespace; unknown names pass
+ * through unchanged. */
+uint64_t replay_name(ReplayNamespace ns, uint64_t captured)
+{
+    NameMap *m = &maps[ns];
+    if (!captured || !m->count)
+        return captured;
+    size_t s = slot(m, captured);
+    return m->keys[s] == captured ? m->values[s] : captured;
+}
+
+void replay_bind_name(ReplayNamespace ns, uint64_t captured, uint64_t actual)
+{
+    NameMap *m = &maps[ns];
+    if ((m->count + 1) * 2 > m->capacity)
+        map_grow(m);
+    size_t s = slot(m, captured);
+    m->count += m->keys[s] != captured;
+    m->keys[s] = captured;
+    m->values[s] = actual;
+}
+
+GLuint *replay_scratch(GLsizei n)
+{
+    if (n > scratch_capacity) {
+        scratch_capacity = n;
+        scratch = realloc(scratch, sizeof(GLuint) * n);
+        if (!scratch) {
+            log_fatal("replay: out of memory for %d names", n);
+            exit(1);
+        }
+    }
+    return scratch;
+}
+
+GLuint *replay_names(ReplayNamespace ns, GLsizei n)
+{
+    GLuint *names = replay_scratch(n);
+    for (GLsizei i = 0; i < n; i++)
+        names[i] = replay_name(ns, replay_u32());
+    return names;
+}
+
+void replay_bind_names(ReplayNamespace ns, GLsizei n, const GLuint *actual)
+{
+    for (GLsizei i = 0; i < n; i++)
+        replay_bind_name(ns, replay_u32(), actual[i]);
+}
+
+/* Query results are discarded; the calls still run for their cost. */
+void *replay_out(int slot)
+{
+    return out[slot];
+}
+
+/* For glObjectLabel(), where the namespace is an argument. */
+GLuint replay_object(GLenum identifier, GLuint captured)
+{
+    switch (identifier) {
+    case GL_BUFFER:
+        return replay_name(REPLAY_BUFFER, captured);
+    case GL_VERTEX_ARRAY:
+        return replay_name(REPLAY_VERTEX_ARRAY, captured);
+    case GL_SHADER:
+        return replay_name(REPLAY_SHADER, captured);
+    case GL_PROGRAM:
+        return replay_name(REPLAY_PROGRAM, captured);
+    case GL_FRAMEBUFFER:
+        return replay_name(REPLAY_FRAMEBUFFER, captured);
+    case GL_RENDERBUFFER:
+        return replay_name(REPLAY_RENDERBUFFER, captured);
+    case GL_QUERY:
+        return replay_name(REPLAY_QUERY, captured);
+    default:
+        return captured;
+    }
+}
+
+void replay_use_program(GLuint captured)
+{
+    current_program = captured;
+}
+
+GLint replay_location(GLint captured)
+{
+    if (captured < 0)
+        return captured;
+    return (GLint) replay_name(REPLAY_LOCATION, (uint64_t) current_program << 32 | (uint32_t) captured);
+}
+
+void replay_bind_location(GLuint captured_program, GLint captured, GLint actual)
+{
+    if (captured >= 0)
+        replay_bind_name(REPLAY_LOCATION, (uint64_t) captured_program << 32 | (uint32_t) captured, (uint32_t) actual);
+}
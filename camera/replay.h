@@ -0,0 +1,50 @@
+#pragma once
+#include "gl_loader.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define REPLAY_OUT_SIZE (1 << 16)   /* per scratch slot for query results */
+#define REPLAY_OUT_SLOTS 4
+
+/* Object namespaces; names the driver hands out during replay generally
+ * differ from the captured ones. */
+typedef enum {
+    REPLAY_BUFFER,
+    REPLAY_VERTEX_ARRAY,
+    REPLAY_SHADER,
+    REPLAY_PROGRAM,
+    REPLAY_FRAMEBUFFER,
+    REPLAY_RENDERBUFFER,
+    REPLAY_QUERY,
+    REPLAY_SYNC,
+    REPLAY_LOCATION,        /* keyed by captured program and location */
+    REPLAY_NAMESPACE_COUNT
+} ReplayNamespace;
+
+/* Stream reader for the generated gl_replay.c; see capture.h for the
+ * encoding. */
+void replay_open(const unsigned char *data, size_t size);
+size_t replay_tell(void);
+void replay_seek(size_t offset);
+uint16_t replay_call_id(void);
+uint32_t replay_u32(void);
+uint64_t replay_u64(void);
+float replay_f32(void);
+const void *replay_bytes(void);
+const char *replay_string(void);
+
+uint64_t replay_name(ReplayNamespace ns, uint64_t captured);
+void replay_bind_name(ReplayNamespace ns, uint64_t captured, uint64_t actual);
+GLuint *replay_names(ReplayNamespace ns, GLsizei n);
+void replay_bind_names(ReplayNamespace ns, GLsizei n, const GLuint *actual);
+GLuint *replay_scratch(GLsizei n);
+void *replay_out(int slot);
+void replay_use_program(GLuint captured);
+GLuint replay_object(GLenum identifier, GLuint captured);
+GLint replay_location(GLint captured);
+void replay_bind_location(GLuint captured_program, GLint captured, GLint actual);
+
+/* Generated: executes one call with its arguments read from the stream.
+ * id indexes gl_loader_names. */
+bool gl_replay_call(unsigned int id);
@@ -0,0 +1,343 @@
+#include "resource.h"
+#include "gl_shader.h"
+#include "gl_debug.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    RESOURCE_BUFFER,
+    RESOURCE_PROGRAM,
+    RESOURCE_KIND_COUNT
+} ResourceKind;
+
+typedef struct {
+    uint64_t key;               /* content hash, kind and size folded in */
+    GLuint name;
+    ResourceKind kind;
+    unsigned int refs;          /* 0 marks a free entry */
+    size_t size;
+    uint64_t check;             /* second hash, differently seeded */
+    char *source;               /* programs: vertex and fragment source */
+} Resource;
+
+/* uint64_t key to entry index; key 0 marks a free slot. */
+typedef struct {
+    uint64_t *keys;
+    unsigned int *values;
+    size_t count, capacity;     /* capacity is a power of two */
+} IndexMap;
+
+typedef struct {
+    unsigned long acquired, shared, collisions;
+    size_t bytes_saved;
+} ResourceStats;
+
+static Resource *entries;
+static unsigned int entry_count, entry_capacity;
+static unsigned int *free_entries;
+static unsigned int free_count;
+static IndexMap by_content, by_name;
+static ResourceStats stats[RESOURCE_KIND_COUNT];
+
+#define P1 UINT64_C(0x9e3779b185ebca87)
+#define P2 UINT64_C(0xc2b2ae3d27d4eb4f)
+#define P3 UINT64_C(0x165667b19e3779f9)
+#define P4 UINT64_C(0x85ebca77c2b2ae63)
+#define P5 UINT64_C(0x27d4eb2f165667c5)
+
+static inline uint64_t rotl(uint64_t x, int r)
+{
+    return x << r | x >> (64 - r);
+}
+
+static inline uint64_t read64(const unsigned char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t xxh_round(uint64_t acc, uint64_t input)
+{
+    return rotl(acc + input * P2, 31) * P1;
+}
+
+static inline uint64_t xxh_merge(uint64_t h, uint64_t v)
+{
+    return (h ^ xxh_round(0, v)) * P1 + P4;
+}
+
+/* XXH64: four independent 64-bit lanes over 32-byte stripes, several
+ * GB/s on uploads that would take far longer to reach the GPU. */
+uint64_t resource_hash(const void *data, size_t size, uint64_t seed)
+{
+    const unsigned char *p = data, *end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+        for (; end - p >= 32; p += 32) {
+            v1 = xxh_round(v1, read64(p));
+            v2 = xxh_round(v2, read64(p + 8));
+            v3 = xxh_round(v3, read64(p + 16));
+            v4 = xxh_round(v4, read64(p + 24));
+        }
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = xxh_merge(xxh_merge(xxh_merge(xxh_merge(h, v1), v2), v3), v4);
+    } else {
+        h = seed + P5;
+    }
+
+    h += size;
+    for (; end - p >= 8; p += 8)
+        h = rotl(h ^ xxh_round(0, read64(p)), 27) * P1 + P4;
+    if (end - p >= 4) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        h = rotl(h ^ v * P1, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < end; p++)
+        h = rotl(h ^ *p * P5, 11) * P1;
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    return h ^ h >> 32;
+}
+
+static size_t map_slot(const IndexMap *m, uint64_t key)
+{
+    size_t i = (key * P1) >> 32 & (m->capacity - 1);
+    while (m->keys[i] && m->keys[i] != key)
+        i = (i + 1) & (m->capacity - 1);
+    return i;
+}
+
+static void map_put(IndexMap *m, uint64_t key, unsigned int value)
+{
+    if ((m->count + 1) * 2 > m->capacity) {
+        IndexMap old = *m;
+        m->capacity = old.capacity ? old.capacity * 2 : 64;
+        m->keys = calloc(m->capacity, sizeof(uint64_t));
+        m->values = malloc(sizeof(unsigned int) * m->capacity);
+        if (!m->keys || !m->values) {
+            log_fatal("resource: out of memory growing an index");
+            exit(1);
+        }
+        for (size_t i = 0; i < old.capacity; i++) {
+            if (!old.keys[i])
+                continue;
+            size_t s = map_slot(m, old.keys[i]);
+            m->keys[s] = old.keys[i];
+            m->values[s] = old.values[i];
+        }
+        free(old.keys);
+        free(old.values);
+    }
+    size_t s = map_slot(m, key);
+    m->count += !m->keys[s];
+    m->keys[s] = key;
+    m->values[s] = value;
+}
+
+static bool map_get(const IndexMap *m, uint64_t key, unsigned int *value)
+{
+    if (!m->count)
+        return false;
+    size_t s = map_slot(m, key);
+    if (!m->keys[s])
+        return false;
+    *value = m->values[s];
+    return true;
+}
+
+/* Backward-shift deletion, as in gpumem.c. */
+static void map_del(IndexMap *m, uint64_t key)
+{
+    if (!m->count)
+        return;
+    size_t i = map_slot(m, key);
+    if (!m->keys[i])
+        return;
+    m->count--;
+    for (size_t j = i;;) {
+        m->keys[i] = 0;
+        for (;;) {
+            j = (j + 1) & (m->capacity - 1);
+            if (!m->keys[j])
+                return;
+            size_t home = (m->keys[j] * P1) >> 32 & (m->capacity - 1);
+            if (i <= j ? (home <= i || home > j) : (home <= i && home > j))
+                break;
+        }
+        m->keys[i] = m->keys[j];
+        m->values[i] = m->values[j];
+        i = j;
+    }
+}
+
+static uint64_t name_key(ResourceKind kind, GLuint name)
+{
+    return (uint64_t) (kind + 1) << 32 | name;
+}
+
+/* Returns the entry already holding the content with one more reference,
+ * or NULL. A key match is only trusted when the size, the second hash and
+ * any kept source match too; a collision gets an object of its own. */
+static Resource *find(ResourceKind kind, uint64_t key, size_t size, uint64_t check, const char *source)
+{
+    stats[kind].acquired++;
+    unsigned int i;
+    if (!map_get(&by_content, key, &i))
+        return NULL;
+    const Resource *r = &entries[i];
+    if (r->size != size || r->check != check || (source && memcmp(r->source, source, size))) {
+        stats[kind].collisions++;
+        log_warn("resource: hash collision on %016llx, not sharing", (unsigned long long) key);
+        return NULL;
+    }
+    entries[i].refs++;
+    stats[kind].shared++;
+    stats[kind].bytes_saved += size;
+    return &entries[i];
+}
+
+/* Keeps a copy of source (size bytes) when given. */
+static void add(ResourceKind kind, uint64_t key, GLuint name, size_t size, uint64_t check, const char *source)
+{
+    unsigned int i;
+    if (free_count) {
+        i = free_entries[--free_count];
+    } else {
+        if (entry_count == entry_capacity) {
+            entry_capacity = entry_capacity ? entry_capacity * 2 : 64;
+            entries = realloc(entries, sizeof(Resource) * entry_capacity);
+            free_entries = realloc(free_entries, sizeof(unsigned int) * entry_capacity);
+            if (!entries || !free_entries) {
+                log_fatal("resource: out of memory for %u entries", entry_capacity);
+                exit(1);
+            }
+        }
+        i = entry_count++;
+    }
+    entries[i] = (Resource) {key, name, kind, 1, size, check, NULL};
+    if (source) {
+        if (!(entries[i].source = malloc(size))) {
+            log_fatal("resource: out of memory keeping %zu bytes of source", size);
+            exit(1);
+        }
+        memcpy(entries[i].source, source, size);
+    }
+    /* A colliding entry stays out of the content index. */
+    unsigned int other;
+    if (!map_get(&by_content, key, &other))
+        map_put(&by_content, key, i);
+    map_put(&by_name, name_key(kind, name), i);
+}
+
+/* Drops a reference; returns true when it was the last one. */
+static bool release(ResourceKind kind, GLuint name)
+{
+    unsigned int i;
+    if (!name || !map_get(&by_name, name_key(kind, name), &i)) {
+        log_error("resource: releasing untracked object %u", name);
+        return false;
+    }
+    if (--entries[i].refs)
+        return false;
+    unsigned int indexed;
+    if (map_get(&by_content, entries[i].key, &indexed) && indexed == i)
+        map_del(&by_content, entries[i].key);
+    map_del(&by_name, name_key(kind, name));
+    free(entries[i].source);
+    entries[i].source = NULL;
+    free_entries[free_count++] = i;
+    return true;
+}
+
+/* Seeding with kind and size keeps equal bytes of different kinds or
+ * lengths apart; 0 is the map's empty key. */
+static uint64_t content_key(ResourceKind kind, const void *data, size_t size)
+{
+    uint64_t key = resource_hash(data, size, (uint64_t) size << 1 | kind);
+    return key ? key : 1;
+}
+
+/* Uploads through GL_COPY_WRITE_BUFFER so no binding the caller relies
+ * on, such as a bound VAO's element buffer, changes. */
+GLuint resource_buffer(GpuCategory category, const void *data, size_t size)
+{
+    uint64_t key = content_key(RESOURCE_BUFFER, data, size);
+    uint64_t check = resource_hash(data, size, ~key);
+    Resource *r = find(RESOURCE_BUFFER, key, size, check, NULL);
+    if (r)
+        return r->name;
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, data, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    gpumem_alloc(GPUMEM_BUFFER, buffer, category, size);
+    gl_debug_label(GL_BUFFER, buffer, "%s %016llx", gpumem_category_name(category), (unsigned long long) key);
+    add(RESOURCE_BUFFER, key, buffer, size, check, NULL);
+    return buffer;
+}
+
+void resource_release_buffer(GLuint buffer)
+{
+    if (!release(RESOURCE_BUFFER, buffer))
+        return;
+    gpumem_free(GPUMEM_BUFFER, buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+/* Bytes releasing buffer would free: its size while it has a single
+ * reference, 0 while shared. */
+size_t resource_buffer_exclusive(GLuint buffer)
+{
+    unsigned int i;
+    if (!buffer || !map_get(&by_name, name_key(RESOURCE_BUFFER, buffer), &i))
+        return 0;
+    return entries[i].refs == 1 ? entries[i].size : 0;
+}
+
+GLuint resource_program(const char *vert_shader_str, const char *frag_shader_str)
+{
+    /* Both sources with their terminators, compared on a hit. */
+    size_t vert_len = strlen(vert_shader_str) + 1, frag_len = strlen(frag_shader_str) + 1;
+    char *source = malloc(vert_len + frag_len);
+    if (!source) {
+        log_error("resource: out of memory for shader sources");
+        return 0;
+    }
+    memcpy(source, vert_shader_str, vert_len);
+    memcpy(source + vert_len, frag_shader_str, frag_len);
+
+    size_t size = vert_len + frag_len;
+    uint64_t key = content_key(RESOURCE_PROGRAM, source, size);
+    Resource *r = find(RESOURCE_PROGRAM, key, size, 0, source);
+    GLuint program = r ? r->name : gl_create_program_from_str(vert_shader_str, frag_shader_str);
+    if (!r && program)
+        add(RESOURCE_PROGRAM, key, program, size, 0, source);
+    free(source);
+    return program;
+}
+
+void resource_release_program(GLuint program)
+{
+    if (release(RESOURCE_PROGRAM, program))
+        glDeleteProgram(program);
+}
+
+void resource_report(void)
+{
+    const ResourceStats *b = &stats[RESOURCE_BUFFER], *p = &stats[RESOURCE_PROGRAM];
+    log_info("resource: %lu of %lu buffers shared, %.1f KiB not uploaded; %lu of %lu programs shared",
+             b->shared, b->acquired, b->bytes_saved / 1024.0, p->shared, p->acquired);
+    if (b->collisions || p->collisions)
+        log_warn("resource: %lu buffer and %lu program hash collisions", b->collisions, p->collisions);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "gl_loader.h"
+#include "gpumem.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Content-addressed GL objects.
+ *
+ * Acquiring a buffer or program hashes its content (XXH64) and hands out
+ * the existing object with one more reference when the same content was
+ * uploaded before; releasing the last reference deletes it. Identical
+ * meshes thus share their vertex and index buffers (each keeps its own
+ * VAO, which holds per-object instance state), and identical shader
+ * sources one program. A hash match is confirmed by the size and a second
+ * hash for buffers and by comparing a kept copy of the sources for
+ * programs; colliding content gets an object of its own.
+ * resource_report() logs how much was deduplicated. The thread owning the
+ * context only. */
+GLuint resource_buffer(GpuCategory category, const void *data, size_t size);
+void resource_release_buffer(GLuint buffer);
+size_t resource_buffer_exclusive(GLuint buffer);
+GLuint resource_program(const char *vert_shader_str, const char *frag_shader_str);
+void resource_release_program(GLuint program);
+void resource_report(void);
+
+uint64_t resource_hash(const void *data, size_t size, uint64_t seed);
@@ -0,0 +1,170 @@
+#include "scene.h"
+#include "log.h"
+#include "gl_debug.h"
+#include "gpumem.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GROW(s, field) s->field = realloc(s->field, sizeof(*s->field) * s->capacity)
+
+static void scene_reserve(Scene *s, unsigned int capacity)
+{
+    if (capacity <= s->capacity)
+        return;
+
+    s->capacity = capacity;
+    GROW(s, parent);
+    GROW(s, position);
+    GROW(s, rotation);
+    GROW(s, scale);
+    GROW(s, world);
+    GROW(s, dirty);
+    GROW(s, changed);
+
+    if (!s->parent || !s->position || !s->rotation || !s->scale || !s->world || !s->dirty || !s->changed) {
+        log_fatal("scene: out of memory growing to %u nodes", capacity);
+        exit(1);
+    }
+}
+
+static void mark_dirty(Scene *s, int node)
+{
+    s->dirty[node] = 1;
+    if ((unsigned int) node < s->first_dirty)
+        s->first_dirty = node;
+}
+
+void scene_init(Scene *s, unsigned int capacity)
+{
+    memset(s, 0, sizeof(*s));
+    scene_reserve(s, capacity ? capacity : 16);
+}
+
+void scene_destroy(Scene *s)
+{
+    free(s->parent);
+    free(s->position);
+    free(s->rotation);
+    free(s->scale);
+    free(s->world);
+    free(s->dirty);
+    free(s->changed);
+    memset(s, 0, sizeof(*s));
+}
+
+int scene_add(Scene *s, int parent, vec3 position, versor rotation, vec3 scale)
+{
+    if (parent >= (int) s->count) {
+        log_error("scene: parent %d must be added before its children", parent);
+        return -1;
+    }
+    if (s->count == s->capacity)
+        scene_reserve(s, s->capacity * 2);
+
+    int node = s->count++;
+    s->parent[node] = parent;
+    glm_vec3_copy(position, s->position[node]);
+    glm_vec4_copy(rotation, s->rotation[node]);
+    glm_vec3_copy(scale, s->scale[node]);
+    mark_dirty(s, node);
+    return node;
+}
+
+void scene_set_position(Scene *s, int node, vec3 position)
+{
+    glm_vec3_copy(position, s->position[node]);
+    mark_dirty(s, node);
+}
+
+void scene_set_rotation(Scene *s, int node, versor rotation)
+{
+    glm_vec4_copy(rotation, s->rotation[node]);
+    mark_dirty(s, node);
+}
+
+void scene_set_scale(Scene *s, int node, vec3 scale)
+{
+    glm_vec3_copy(scale, s->scale[node]);
+    mark_dirty(s, node);
+}
+
+/* Recompute world matrices of dirty nodes and everything below them. A
+ * child inherits the flag from its parent during the same pass, so only
+ * dirty subtrees are touched and nodes before the first dirty one are
+ * never visited. */
+void scene_update(Scene *s)
+{
+    s->changed_count = 0;
+
+    for (unsigned int i = s->first_dirty; i < s->count; i++) {
+        int p = s->parent[i];
+        if (!s->dirty[i] && (p == SCENE_NO_PARENT || !s->dirty[p]))
+            continue;
+        s->dirty[i] = 1;
+
+        mat4 local;
+        glm_quat_mat4(s->rotation[i], local);
+        glm_scale(local, s->scale[i]);
+        local[3][0] = s->position[i][0];
+        local[3][1] = s->position[i][1];
+        local[3][2] = s->position[i][2];
+
+        if (p == SCENE_NO_PARENT)
+            glm_mat4_copy(local, s->world[i]);
+        else
+            glm_mat4_mul(s->world[p], local, s->world[i]);
+
+        s->changed[s->changed_count++] = i;
+    }
+
+    for (unsigned int i = 0; i < s->changed_count; i++)
+        s->dirty[s->changed[i]] = 0;
+    s->first_dirty = s->count;
+}
+
+/* Copy changed world matrices into an instance buffer holding one mat4 per
+ * node. They are packed into the stream ring and copied over on the GPU,
+ * one glCopyBufferSubData per run of consecutive nodes, so the instance
+ * buffer is never written while earlier frames still read it. When the
+ * ring is full each run goes up with glBufferSubData instead. */
+void scene_upload(Scene *s, GLuint buffer, StreamBuffer *stream)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    if (s->uploaded_capacity < s->count) {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(mat4) * s->capacity, NULL, GL_DYNAMIC_DRAW);
+        gpumem_alloc(GPUMEM_BUFFER, buffer, GPUMEM_INSTANCES, sizeof(mat4) * s->capacity);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(mat4) * s->count, s->world);
+        s->uploaded_capacity = s->capacity;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        gl_debug_label(GL_BUFFER, buffer, "scene instances");
+        return;
+    }
+
+    GLintptr offset = 0;
+    mat4 *staged = NULL;
+    if (s->changed_count) {
+        staged = stream_alloc(stream, sizeof(mat4) * s->changed_count, sizeof(mat4), &offset);
+        if (staged) {
+            for (unsigned int i = 0; i < s->changed_count; i++)
+                memcpy(staged[i], s->world[s->changed[i]], sizeof(mat4));
+            stream_flush(stream);
+            glBindBuffer(GL_COPY_READ_BUFFER, stream->buffer);
+        }
+    }
+
+    for (unsigned int i = 0, j; i < s->changed_count; i = j) {
+        unsigned int first = s->changed[i];
+        for (j = i + 1; j < s->changed_count && s->changed[j] == first + (j - i); j++);
+        if (staged)
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, offset + sizeof(mat4) * i,
+                                sizeof(mat4) * first, sizeof(mat4) * (j - i));
+        else
+            glBufferSubData(GL_ARRAY_BUFFER, sizeof(mat4) * first, sizeof(mat4) * (j - i), s->world[first]);
+    }
+
+    if (staged)
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "gl_loader.h"
+#include "stream.h"
+#include <cglm/cglm.h>
+
+#define SCENE_NO_PARENT -1
+
+/* Transform hierarchy in SoA layout. Nodes are stored parent-before-child
+ * (parent[i] < i), so one forward pass over the arrays sees every parent's
+ * world matrix before its children need it. */
+typedef struct {
+    unsigned int count, capacity;
+    int *parent;
+    vec3 *position;
+    versor *rotation;
+    vec3 *scale;
+    mat4 *world;
+    unsigned char *dirty;
+    unsigned int first_dirty;
+
+    /* Nodes whose world matrix changed in the last scene_update(), ascending. */
+    unsigned int *changed;
+    unsigned int changed_count;
+    unsigned int uploaded_capacity;
+} Scene;
+
+void scene_init(Scene *s, unsigned int capacity);
+void scene_destroy(Scene *s);
+int scene_add(Scene *s, int parent, vec3 position, versor rotation, vec3 scale);
+void scene_set_position(Scene *s, int node, vec3 position);
+void scene_set_rotation(Scene *s, int node, versor rotation);
+void scene_set_scale(Scene *s, int node, vec3 scale);
+void scene_update(Scene *s);
+void scene_upload(Scene *s, GLuint buffer, StreamBuffer *stream);
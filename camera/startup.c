@@ -0,0 +1,42 @@
+#include "startup.h"
+#include "log.h"
+#include <stdbool.h>
+#include <time.h>
+
+static double begin_ms, last_ms;
+static bool running;
+
+static double now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec * 1e-6;
+}
+
+void startup_begin(void)
+{
+    begin_ms = last_ms = now_ms();
+    running = true;
+}
+
+void startup_phase(const char *name)
+{
+    if (!running)
+        return;
+    double now = now_ms();
+    log_info("startup: %-14s %8.2f ms  (total %8.2f ms)", name, now - last_ms, now - begin_ms);
+    last_ms = now;
+}
+
+void startup_done(void)
+{
+    if (!running)
+        return;
+    startup_phase("first frame");
+    running = false;
+}
+
+double startup_elapsed_ms(void)
+{
+    return now_ms() - begin_ms;
+}
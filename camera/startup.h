@@ -0,0 +1,9 @@
+#pragma once
+
+/* Startup phase timing on CLOCK_MONOTONIC. Each startup_phase() logs the
+ * time since the previous phase and since startup_begin(); startup_done()
+ * logs time to first frame and turns further calls into no-ops. */
+void startup_begin(void);
+void startup_phase(const char *name);
+void startup_done(void);
+double startup_elapsed_ms(void);
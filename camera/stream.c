@@ -0,0 +1,181 @@
+#include "stream.h"
+#include "capture.h"
+#include "gl_debug.h"
+#include "gpumem.h"
+#include "window.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Regions start on this boundary, the largest uniform buffer offset
+ * alignment drivers report. */
+#define STREAM_REGION_ALIGN 256
+
+#define PERSISTENT_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+void stream_init(StreamBuffer *s, size_t size)
+{
+    memset(s, 0, sizeof(*s));
+
+    const char *env = getenv("STREAM_BUFFER_KB");
+    if (!size)
+        size = (env ? strtoull(env, NULL, 10) : STREAM_DEFAULT_KB) << 10;
+    s->region_size = size / STREAM_REGIONS & ~(size_t) (STREAM_REGION_ALIGN - 1);
+    if (!s->region_size)
+        s->region_size = STREAM_REGION_ALIGN;
+    s->size = s->region_size * STREAM_REGIONS;
+    s->region = STREAM_REGIONS - 1;
+
+    GLint align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+    s->uniform_align = align > 0 ? (size_t) align : STREAM_REGION_ALIGN;
+
+    env = getenv("STREAM_PERSISTENT");
+    s->persistent = gl_loader_has(GL_LOADER_ARB_buffer_storage) && !(env && !atoi(env));
+
+    glGenBuffers(1, &s->buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+    if (s->persistent) {
+        /* Dynamic storage allows the glBufferSubData() uploads made while capturing. */
+        glBufferStorage(GL_COPY_WRITE_BUFFER, s->size, NULL, PERSISTENT_FLAGS | GL_DYNAMIC_STORAGE_BIT);
+        s->persistent_map = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, s->size, PERSISTENT_FLAGS);
+        if (!s->persistent_map) {
+            log_warn("stream: persistent mapping failed, mapping per batch");
+            glDeleteBuffers(1, &s->buffer);
+            glGenBuffers(1, &s->buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+            s->persistent = false;
+        }
+    }
+    if (!s->persistent)
+        glBufferData(GL_COPY_WRITE_BUFFER, s->size, NULL, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    gpumem_alloc(GPUMEM_BUFFER, s->buffer, GPUMEM_STREAMING, s->size);
+    gl_debug_label(GL_BUFFER, s->buffer, "stream ring");
+    log_info("stream: %zu KiB in %d regions, %s", s->size >> 10, STREAM_REGIONS,
+             s->persistent ? "persistently mapped" : "mapped unsynchronized per batch");
+}
+
+void stream_destroy(StreamBuffer *s)
+{
+    stream_flush(s);
+    for (int i = 0; i < STREAM_REGIONS; i++)
+        if (s->fences[i])
+            glDeleteSync(s->fences[i]);
+    if (s->persistent_map) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    gpumem_free(GPUMEM_BUFFER, s->buffer);
+    glDeleteBuffers(1, &s->buffer);
+    free(s->shadow);
+    memset(s, 0, sizeof(*s));
+}
+
+/* Moves to the next region, waiting until the GPU has finished the frame
+ * that last used it. With the frame pacer in front this rarely blocks. */
+void stream_begin_frame(StreamBuffer *s)
+{
+    s->region = (s->region + 1) % STREAM_REGIONS;
+    s->head = s->flushed = 0;
+
+    GLsync *fence = &s->fences[s->region];
+    if (*fence) {
+        double start = window_time();
+        glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(*fence);
+        *fence = NULL;
+        s->fence_wait += window_time() - start;
+    }
+}
+
+/* Points s->map at memory for the rest of the region. */
+static bool begin_batch(StreamBuffer *s)
+{
+    size_t base = (size_t) s->region * s->region_size;
+    if (capture_active()) {
+        if (!s->shadow && !(s->shadow = malloc(s->size))) {
+            log_error("stream: out of memory for a %zu KiB capture copy", s->size >> 10);
+            return false;
+        }
+        s->map = s->shadow;
+        s->map_offset = 0;
+    } else if (s->persistent) {
+        s->map = s->persistent_map;
+        s->map_offset = 0;
+    } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+        s->map = glMapBufferRange(GL_COPY_WRITE_BUFFER, base + s->head, s->region_size - s->head,
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                  GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        if (!s->map) {
+            log_error("stream: mapping region %u failed", s->region);
+            return false;
+        }
+        s->map_offset = base + s->head;
+    }
+    return true;
+}
+
+/* Returns size bytes at a multiple of align (a power of two) in the
+ * current region and their offset in s->buffer, or NULL when the region
+ * has no room left. */
+void *stream_alloc(StreamBuffer *s, size_t size, size_t align, GLintptr *offset)
+{
+    size_t head = (s->head + align - 1) & ~(align - 1);
+    if (head + size > s->region_size) {
+        s->overflows++;
+        return NULL;
+    }
+    if (!s->map && !begin_batch(s))
+        return NULL;
+
+    s->head = head + size;
+    *offset = (GLintptr) ((size_t) s->region * s->region_size + head);
+    return s->map + (*offset - s->map_offset);
+}
+
+/* Makes everything allocated since the last flush visible to GL. Call
+ * before the commands that read it. */
+void stream_flush(StreamBuffer *s)
+{
+    if (!s->map)
+        return;
+    size_t start = (size_t) s->region * s->region_size + s->flushed;
+    size_t size = s->head - s->flushed;
+
+    if (s->map == s->shadow) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, start, size, s->shadow + start);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    } else if (!s->persistent) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, s->buffer);
+        if (size)
+            glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, start - s->map_offset, size);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    s->map = NULL;
+    s->flushed = s->head;
+}
+
+void stream_end_frame(StreamBuffer *s)
+{
+    stream_flush(s);
+    if (s->head > s->peak)
+        s->peak = s->head;
+    s->fences[s->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/* Logs usage and waits since the last report, then resets. */
+void stream_report(StreamBuffer *s)
+{
+    log_info("stream: peak %.1f of %.1f KiB per frame, %.2f ms fence wait, %lu overflows",
+             s->peak / 1024.0, s->region_size / 1024.0, s->fence_wait * 1e3, s->overflows);
+    s->peak = 0;
+    s->fence_wait = 0.0;
+    s->overflows = 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "gl_loader.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#define STREAM_REGIONS 3                /* frames the GPU may still be reading */
+#define STREAM_DEFAULT_KB 3072
+
+/* Streaming ring buffer for per-frame dynamic data.
+ *
+ * One buffer split into STREAM_REGIONS per-frame regions. Each frame bump
+ * allocates from its own region, and a fence at stream_end_frame() guards
+ * the region until the GPU is done with it, so writing is a plain memcpy
+ * that never waits on the driver. With ARB_buffer_storage the whole
+ * buffer stays mapped persistent and coherent. On plain GL 3.3 each batch
+ * of allocations is mapped unsynchronized, which the fences make safe.
+ *
+ * Usage per frame: stream_begin_frame(), then any number of
+ * stream_alloc() + writes + stream_flush() before the GL commands reading
+ * the data, then stream_end_frame(). stream_alloc() returns NULL when the
+ * region is full; the caller uploads some other way.
+ *
+ * Writes through a mapping bypass the GL capture, so while a capture is
+ * running the allocations point at a CPU copy instead and stream_flush()
+ * uploads them with glBufferSubData().
+ *
+ * Uniform data bound with glBindBufferRange() must start at a multiple of
+ * uniform_align.
+ *
+ * size 0 reads $STREAM_BUFFER_KB (default STREAM_DEFAULT_KB);
+ * $STREAM_PERSISTENT=0 forces the GL 3.3 path. The thread owning the
+ * context only. */
+typedef struct {
+    GLuint buffer;
+    size_t size, region_size;
+    size_t uniform_align;       /* GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT */
+    unsigned int region;
+    size_t head;                /* bytes allocated in the current region */
+    size_t flushed;             /* head at the last stream_flush() */
+    bool persistent;
+    unsigned char *persistent_map;
+    unsigned char *map;         /* current batch: its mapping or the shadow */
+    size_t map_offset;          /* buffer offset map points at */
+    unsigned char *shadow;      /* CPU copy while capturing */
+    GLsync fences[STREAM_REGIONS];
+
+    double fence_wait;          /* seconds, since the last report */
+    size_t peak;                /* bytes in one frame, since the last report */
+    unsigned long overflows;
+} StreamBuffer;
+
+void stream_init(StreamBuffer *s, size_t size);
+void stream_destroy(StreamBuffer *s);
+void stream_begin_frame(StreamBuffer *s);
+void *stream_alloc(StreamBuffer *s, size_t size, size_t align, GLintptr *offset);
+void stream_flush(StreamBuffer *s);
+void stream_end_frame(StreamBuffer *s);
+void stream_report(StreamBuffer *s);
@@ -0,0 +1,44 @@
+#include "timestep.h"
+#include "log.h"
+#include <stdlib.h>
+
+void timestep_init(Timestep *t, double rate, unsigned int max_steps, double now)
+{
+    if (rate <= 0.0) {
+        const char *env = getenv("SIM_HZ");
+        rate = env ? atof(env) : TIMESTEP_DEFAULT_RATE;
+        if (rate <= 0.0) {
+            log_error("timestep: invalid SIM_HZ '%s', using %.0f Hz", env, TIMESTEP_DEFAULT_RATE);
+            rate = TIMESTEP_DEFAULT_RATE;
+        }
+    }
+
+    *t = (Timestep) {.step = 1.0 / rate, .last = now, .max_steps = max_steps ? max_steps : 1};
+    log_info("timestep: %.1f Hz, at most %u ticks per frame", rate, t->max_steps);
+}
+
+/* Returns how many ticks of t->step the caller must simulate now and sets
+ * t->alpha for interpolating the render state. After a stall (debugger,
+ * window drag) at most max_steps run and the rest is dropped, so a slow
+ * simulation can't spiral by falling further behind each frame. */
+unsigned int timestep_advance(Timestep *t, double now)
+{
+    double elapsed = now - t->last;
+    t->last = now;
+    if (elapsed > 0.0)
+        t->accumulator += elapsed;
+
+    unsigned int steps = t->accumulator / t->step;
+    if (steps > t->max_steps) {
+        double excess = (steps - t->max_steps) * t->step;
+        t->accumulator -= excess;
+        t->dropped += excess;
+        steps = t->max_steps;
+    }
+
+    t->accumulator -= steps * t->step;
+    t->ticks += steps;
+    t->time = t->ticks * t->step;
+    t->alpha = t->accumulator / t->step;
+    return steps;
+}
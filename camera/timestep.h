@@ -0,0 +1,22 @@
+#pragma once
+
+#define TIMESTEP_RATE_AUTO 0.0     /* $SIM_HZ, else TIMESTEP_DEFAULT_RATE */
+#define TIMESTEP_DEFAULT_RATE 120.0
+#define TIMESTEP_MAX_STEPS 8       /* catch-up ticks per frame before time is dropped */
+
+/* Fixed-rate simulation clock. Wall time goes in as double seconds from any
+ * monotonic source; a headless run can feed it a synthetic clock to step
+ * faster than real time. */
+typedef struct {
+    double step;            /* seconds per tick */
+    double last;            /* wall time seen by the previous advance */
+    double accumulator;     /* wall time not yet simulated, < step after advance */
+    double time;            /* simulated time */
+    double dropped;         /* wall time discarded by the catch-up limit */
+    unsigned long ticks;
+    unsigned int max_steps;
+    float alpha;            /* render blend between the last two states, 0..1 */
+} Timestep;
+
+void timestep_init(Timestep *t, double rate, unsigned int max_steps, double now);
+unsigned int timestep_advance(Timestep *t, double now);
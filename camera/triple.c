@@ -0,0 +1,40 @@
+#include "triple.h"
+
+void triple_init(TripleBuffer *t)
+{
+    t->write = 0;
+    t->read = 1;
+    atomic_init(&t->ready, 2);
+    t->published = t->acquired = 0;
+}
+
+unsigned int triple_write_slot(const TripleBuffer *t)
+{
+    return t->write;
+}
+
+/* Swaps the filled slot with the spare; release so the contents are
+ * visible to whoever acquires it. */
+void triple_publish(TripleBuffer *t)
+{
+    unsigned int old = atomic_exchange_explicit(&t->ready, t->write | TRIPLE_FRESH, memory_order_acq_rel);
+    t->write = old & ~TRIPLE_FRESH;
+    t->published++;
+}
+
+/* Takes the newest published slot if there is one. Returns false, keeping
+ * the current read slot, when nothing was published since the last call. */
+bool triple_acquire(TripleBuffer *t)
+{
+    if (!(atomic_load_explicit(&t->ready, memory_order_relaxed) & TRIPLE_FRESH))
+        return false;
+    unsigned int old = atomic_exchange_explicit(&t->ready, t->read, memory_order_acq_rel);
+    t->read = old & ~TRIPLE_FRESH;
+    t->acquired++;
+    return true;
+}
+
+unsigned int triple_read_slot(const TripleBuffer *t)
+{
+    return t->read;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+
+/* Lock-free triple buffer of slot indices for one writer and one reader.
+ * The writer fills slots[triple_write_slot()] and publishes it; the reader
+ * picks up the newest published slot. Neither side ever waits, and the
+ * reader never sees a slot the writer is still filling. The caller owns
+ * the three slots. */
+typedef struct {
+    unsigned int write;     /* writer only */
+    unsigned int read;      /* reader only */
+    atomic_uint ready;      /* spare slot, TRIPLE_FRESH once published */
+    unsigned long published, acquired;
+} TripleBuffer;
+
+#define TRIPLE_FRESH 4u
+
+void triple_init(TripleBuffer *t);
+unsigned int triple_write_slot(const TripleBuffer *t);
+void triple_publish(TripleBuffer *t);
+bool triple_acquire(TripleBuffer *t);
+unsigned int triple_read_slot(const TripleBuffer *t);
@@ -1,17 +1,33 @@
 #include "window.h"
+#include "log.h"
+#include "startup.h"
+#include "capture.h"
+#include "gl_debug.h"
+#include "gpumem.h"
+#include <EGL/eglext.h>
+#include <stdlib.h>
+#include <string.h>
 
 static struct Window window;
+static struct timespec start_time;
+
+/* Seconds since the window was created, on the clock input events are
+ * stamped with. Works without GLFW, unlike glfwGetTime(). */
+double window_time(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec - start_time.tv_sec) + (t.tv_nsec - start_time.tv_nsec) * 1e-9;
+}
 
 void handle_keys(GLFWwindow* win, int key, int code, int action, int mode)
 {
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(win, GL_TRUE);
 
-    if (key >= 0 && key < 1024) {
-        if (action == GLFW_PRESS)
-            window.keys[key] = true;
-        else if (action == GLFW_RELEASE)
-            window.keys[key] = false;
+    if (key >= 0 && key < INPUT_KEYS && action != GLFW_REPEAT) {
+        InputEvent e = {window_time(), action == GLFW_PRESS ? INPUT_KEY_DOWN : INPUT_KEY_UP, key, 0.0f, 0.0f};
+        input_push(&window.input, &e);
     }
 }
 
@@ -23,29 +39,57 @@ void handle_mouse(GLFWwindow* win, double x, double y)
         window.mouse_flag = false;
     }
 
-    window.x_change = x - window.x_last;
-    window.y_change = y - window.y_last;
+    InputEvent e = {window_time(), INPUT_MOUSE_MOVE, 0, x - window.x_last, y - window.y_last};
+    input_push(&window.input, &e);
 
     window.x_last = x;
     window.y_last = y;
 }
 
+/* Window managers may resize a window after mapping it. The GL context
+ * may live on another thread, so the viewport follows the size there. */
+void handle_resize(GLFWwindow* win, int width, int height)
+{
+    (void) win;
+    window.b_width = width;
+    window.b_height = height;
+    window.ready = true;
+    window.damage |= DAMAGE_RESIZE;
+}
+
+void handle_refresh(GLFWwindow* win)
+{
+    (void) win;
+    window.ready = true;
+    window.damage |= DAMAGE_EXPOSE;
+}
 
 struct Window *init_window()
 {
+    const char *headless = getenv("HEADLESS");
+    if (headless && *headless && strcmp(headless, "0")) {
+        const char *frames = getenv("HEADLESS_FRAMES");
+        return init_headless_window(1898, 992, frames ? strtoul(frames, NULL, 10) : HEADLESS_DEFAULT_FRAMES);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
     window.w = 1898;
     window.h = 992;
-    window.x_change = 0.0f;
-    window.y_change = 0.0f;
+    window.mouse_flag = true;
+    input_init(&window.input);
 
     if (!glfwInit()) {
         glfwTerminate();
         exit(1);
     }
+    startup_phase("glfw init");
     glfwWindowHint(GLFW_SAMPLES, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GL_DEBUG
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
     window.win = glfwCreateWindow(window.w, window.h, "Test", NULL, NULL);
 
     if (!window.win) {
@@ -53,27 +97,221 @@ struct Window *init_window()
         exit(1);
     }
 
-    struct timespec t = {.tv_sec = 1};
-    nanosleep(&t, &t);
-
     glfwGetFramebufferSize(window.win, &window.b_width, &window.b_height);
     glfwMakeContextCurrent(window.win);
+    startup_phase("context");
 
     glfwSetKeyCallback(window.win, handle_keys);
     glfwSetCursorPosCallback(window.win, handle_mouse);
+    glfwSetFramebufferSizeCallback(window.win, handle_resize);
+    glfwSetWindowRefreshCallback(window.win, handle_refresh);
     glfwSetInputMode(window.win, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
-    glewExperimental = true;
-
-    if (glewInit() != GLEW_OK) {
-        glfwDestroyWindow(window.win);
-        glfwTerminate();
-        exit(1);
-    }
+    gl_loader_init((GLLoaderGetProc) glfwGetProcAddress);
+    gl_debug_init();
+    capture_init(window.b_width, window.b_height);
+    startup_phase("loader");
 
     glEnable(GL_DEPTH_TEST);
 
     glViewport(0, 0, window.b_width, window.b_height);
     glfwSetWindowUserPointer(window.win, window.win);
+
+    /* Rather than sleeping a fixed time for the window manager, wait until
+     * it has configured or exposed the window. Bounded, since some never
+     * send either for a window that is already the right size. */
+    double deadline = window_time() + WINDOW_READY_TIMEOUT;
+    glfwPollEvents();
+    while (!window.ready && window_time() < deadline)
+        glfwWaitEventsTimeout(deadline - window_time());
+    startup_phase(window.ready ? "window ready" : "window timeout");
     return &window;
 }
+
+/* Surfaceless Mesa display first (no X, no GPU needed: llvmpipe), then
+ * whatever the default display is. */
+static EGLDisplay open_egl_display(void)
+{
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLint major, minor;
+
+    if (get_platform_display) {
+        EGLDisplay dpy = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (dpy != EGL_NO_DISPLAY && eglInitialize(dpy, &major, &minor))
+            return dpy;
+    }
+
+    EGLDisplay dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (dpy != EGL_NO_DISPLAY && eglInitialize(dpy, &major, &minor))
+        return dpy;
+    return EGL_NO_DISPLAY;
+}
+
+static void headless_fail(const char *what)
+{
+    log_fatal("headless: %s failed (EGL error 0x%x)", what, eglGetError());
+    exit(1);
+}
+
+struct Window *init_headless_window(int w, int h, unsigned long max_frames)
+{
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    window.w = window.b_width = w;
+    window.h = window.b_height = h;
+    window.headless = true;
+    window.max_frames = max_frames;
+    input_init(&window.input);
+
+    window.egl_display = open_egl_display();
+    if (window.egl_display == EGL_NO_DISPLAY)
+        headless_fail("opening an EGL display");
+    startup_phase("egl init");
+    if (!eglBindAPI(EGL_OPENGL_API))
+        headless_fail("eglBindAPI(EGL_OPENGL_API)");
+
+    const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_NONE
+    };
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#ifdef GL_DEBUG
+        EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configs = 0;
+    eglChooseConfig(window.egl_display, config_attribs, &config, 1, &configs);
+
+    /* Surfaceless displays may expose no configs at all. */
+    window.egl_context = eglCreateContext(window.egl_display, configs ? config : EGL_NO_CONFIG_KHR,
+                                          EGL_NO_CONTEXT, context_attribs);
+    if (window.egl_context == EGL_NO_CONTEXT)
+        headless_fail("creating a GL 3.3 core context");
+    if (!eglMakeCurrent(window.egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, window.egl_context))
+        headless_fail("making the context current without a surface");
+    startup_phase("context");
+
+    gl_loader_init((GLLoaderGetProc) eglGetProcAddress);
+    gl_debug_init();
+    capture_init(w, h);
+    startup_phase("loader");
+
+    glGenFramebuffers(1, &window.fbo);
+    glGenRenderbuffers(1, &window.fbo_color);
+    glGenRenderbuffers(1, &window.fbo_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, window.fbo_color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, window.fbo_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+    /* Drivers pad 24-bit depth to 32. */
+    gpumem_alloc(GPUMEM_RENDERBUFFER, window.fbo_color, GPUMEM_TARGETS, (size_t) w * h * 4);
+    gpumem_alloc(GPUMEM_RENDERBUFFER, window.fbo_depth, GPUMEM_TARGETS, (size_t) w * h * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, window.fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, window.fbo_color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, window.fbo_depth);
+    gl_debug_label(GL_FRAMEBUFFER, window.fbo, "headless framebuffer");
+    gl_debug_label(GL_RENDERBUFFER, window.fbo_color, "headless color");
+    gl_debug_label(GL_RENDERBUFFER, window.fbo_depth, "headless depth");
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        log_fatal("headless: offscreen framebuffer incomplete");
+        exit(1);
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glViewport(0, 0, w, h);
+    window.ready = true;
+    startup_phase("framebuffer");
+    log_info("headless: %dx%d on %s (%s)", w, h, glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    return &window;
+}
+
+void destroy_window(struct Window *w)
+{
+    capture_stop();
+    if (w->headless) {
+        glDeleteFramebuffers(1, &w->fbo);
+        gpumem_free(GPUMEM_RENDERBUFFER, w->fbo_color);
+        gpumem_free(GPUMEM_RENDERBUFFER, w->fbo_depth);
+        glDeleteRenderbuffers(1, &w->fbo_color);
+        glDeleteRenderbuffers(1, &w->fbo_depth);
+        eglMakeCurrent(w->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(w->egl_display, w->egl_context);
+        eglTerminate(w->egl_display);
+    } else {
+        glfwDestroyWindow(w->win);
+        glfwTerminate();
+    }
+}
+
+bool window_should_close(struct Window *w)
+{
+    if (w->headless)
+        return w->max_frames && atomic_load(&w->frame) >= w->max_frames;
+    return glfwWindowShouldClose(w->win);
+}
+
+void window_poll(struct Window *w)
+{
+    if (!w->headless)
+        glfwPollEvents();
+}
+
+/* Sleeps until an event arrives or timeout seconds pass. */
+void window_wait(struct Window *w, double timeout)
+{
+    if (timeout <= 0.0) {
+        window_poll(w);
+    } else if (!w->headless) {
+        glfwWaitEventsTimeout(timeout);
+    } else {
+        struct timespec t = {(time_t) timeout, (long) ((timeout - (time_t) timeout) * 1e9)};
+        nanosleep(&t, NULL);
+    }
+}
+
+/* Hands the GL context to the calling thread; it must first be released
+ * by the thread that had it. */
+void window_make_current(struct Window *w)
+{
+    if (w->headless)
+        eglMakeCurrent(w->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, w->egl_context);
+    else
+        glfwMakeContextCurrent(w->win);
+}
+
+void window_release_current(struct Window *w)
+{
+    if (w->headless)
+        eglMakeCurrent(w->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    else
+        glfwMakeContextCurrent(NULL);
+}
+
+/* Headless frames end in glFinish() so a frame's cost lands in that frame,
+ * the way a blocking swap would bound it with a real display. */
+void window_swap(struct Window *w)
+{
+    atomic_fetch_add(&w->frame, 1);
+    if (w->headless)
+        glFinish();
+    else
+        glfwSwapBuffers(w->win);
+    gl_debug_frame();
+    capture_frame();
+}
+
+/* 0 disables vsync. Headless frames are never synchronised. Needs the
+ * context current on the calling thread. */
+void window_set_swap_interval(struct Window *w, int interval)
+{
+    if (!w->headless)
+        glfwSwapInterval(interval);
+}
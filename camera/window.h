@@ -1,21 +1,50 @@
 #pragma once
-#include <GL/glew.h>
+#include "gl_loader.h"
+#define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
+#include <EGL/egl.h>
 
 #include <cglm/cglm.h>
 #include <time.h>
+#include "input.h"
+#include "redraw.h"
 
 struct Window {
     int w, h;
-    bool keys[1024];
-    GLfloat x_change, y_change;
+    InputRing input;
     GLfloat x_last, y_last;
     int b_width, b_height;
     bool mouse_flag;
-    GLFWwindow *win;
+    bool ready;                 /* first configure/expose seen */
+    unsigned int damage;        /* DAMAGE_RESIZE/EXPOSE from callbacks, main thread */
+    GLFWwindow *win;            /* NULL when headless */
+
+    /* Headless backend: an EGL context without a surface, drawing into fbo. */
+    bool headless;
+    EGLDisplay egl_display;
+    EGLContext egl_context;
+    GLuint fbo, fbo_color, fbo_depth;
+    atomic_ulong frame;         /* swaps so far, bumped on the render thread */
+    unsigned long max_frames;
 };
 
+#define HEADLESS_DEFAULT_FRAMES 600
+#define WINDOW_READY_TIMEOUT 0.25  /* seconds to wait for the first configure/expose */
 
+/* Opens a GLFW window, or the headless backend when $HEADLESS is set
+ * ($HEADLESS_FRAMES frames, 0 for no limit). Exits on failure. */
 struct Window *init_window();
+struct Window *init_headless_window(int w, int h, unsigned long max_frames);
+void destroy_window(struct Window *w);
+bool window_should_close(struct Window *w);
+void window_poll(struct Window *w);
+void window_wait(struct Window *w, double timeout);
+void window_make_current(struct Window *w);
+void window_release_current(struct Window *w);
+void window_swap(struct Window *w);
+void window_set_swap_interval(struct Window *w, int interval);
+double window_time(void);
 void handle_mouse(GLFWwindow* win, double x, double y);
 void handle_keys(GLFWwindow* win, int key, int code, int action, int mode);
+void handle_resize(GLFWwindow* win, int width, int height);
+void handle_refresh(GLFWwindow* win);
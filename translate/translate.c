@@ -16,10 +16,12 @@ bool dir = true;
 float tri_maxoffset = 0.7f;
 float tri_offset = 0.05f;
 mat4 model;
+static bool dirty = true;   /* redraw only when something changed */
 
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     if (GLFW_REPEAT == action) {
+        dirty = true;
         switch (key) {
         case 'W':
             // glm_translate_y(model, tri_offset);
@@ -38,6 +40,20 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
     }
 }
 
+/* The window manager may resize the window after it is mapped. */
+static void resize_callback(GLFWwindow* window, int width, int height)
+{
+    (void) window;
+    glViewport(0, 0, width, height);
+    dirty = true;
+}
+
+static void refresh_callback(GLFWwindow* window)
+{
+    (void) window;
+    dirty = true;
+}
+
 static const char *vshader = GLSL(330,
     layout (location = 0) in vec3 pos;
     out vec4 vCol;
@@ -105,10 +121,6 @@ int main ()
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
     win = glfwCreateWindow(2520, 1342, "Translate", NULL, NULL);
-    struct timespec t;
-    t.tv_nsec = 500000000L;
-    t.tv_sec = 0;
-    nanosleep(&t, &t);
 
     if (!win) {
         glfwTerminate();
@@ -131,25 +143,37 @@ int main ()
     glViewport(0, 0, buffer_width, buffer_height);
 
     glfwSetKeyCallback(win, key_callback);
+    glfwSetFramebufferSizeCallback(win, resize_callback);
+    glfwSetWindowRefreshCallback(win, refresh_callback);
 
     prog = gl_create_program_from_str(vshader, fshader);
     create_triangle();
 
     glClearColor(0.0f, 0.f, 0.3f, 0.0f);
+    /* Nothing animates, so sleep in glfwWaitEvents() until input, a resize
+     * or an expose asks for a new frame. */
     do {
-        glClear(GL_COLOR_BUFFER_BIT);
-        glUseProgram(prog);
-        glUniformMatrix4fv(uniform_model, 1, GL_FALSE, &model[0][0]);
+        if (dirty) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            glUseProgram(prog);
+            glUniformMatrix4fv(uniform_model, 1, GL_FALSE, &model[0][0]);
 
-        glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 3);
-		glBindVertexArray(0);
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glBindVertexArray(0);
 
-		glUseProgram(0);
+            glUseProgram(0);
 
-        glfwSwapBuffers(win);
-        glfwPollEvents();
+            glfwSwapBuffers(win);
+            dirty = false;
+        }
+        glfwWaitEvents();
     } while (glfwGetKey(win, GLFW_KEY_ESCAPE) != GLFW_PRESS && !glfwWindowShouldClose(win));
 
+    glDeleteProgram(prog);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glfwDestroyWindow(win);
+    glfwTerminate();
     return 0;
 }